@@ -0,0 +1,128 @@
+
+/*
+ * bench_fleet.c - Memory and throughput of the packed fleet store
+ *
+ * Steps 100k cells through the test vectors twice: once with full
+ * working structs resident, once through the packed hot/cold store.
+ * Reports bytes per cell, ns per cell-step, the SOC difference and the
+ * cost of persisting the store through a memory-mapped file.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bms_config.h"
+#include "bms_fleet.h"
+#include "test_vectors.h"
+
+#define N_CELLS  (100000u)
+#define N_STEPS  (NUM_TEST_SAMPLES)
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main()
+{
+    printf("========================================\n");
+    printf("FLEET STORE BENCHMARK (%u cells, %u steps)\n", N_CELLS, N_STEPS);
+    printf("========================================\n");
+
+    Fleet_Cell *full = malloc((size_t)N_CELLS * sizeof(Fleet_Cell));
+    const size_t store_bytes = Fleet_StoreSize(N_CELLS);
+    void *mem = malloc(store_bytes);
+    float *I = malloc(N_CELLS * sizeof(float));
+    float *V = malloc(N_CELLS * sizeof(float));
+    float *T = malloc(N_CELLS * sizeof(float));
+    float *soc = malloc(N_CELLS * sizeof(float));
+
+    if (!full || !mem || !I || !V || !T || !soc) {
+        printf("allocation failed\n");
+        return 1;
+    }
+
+    for (uint32_t c = 0; c < N_CELLS; c++) {
+        BMS_Init(&full[c].bms);
+        EKF_Init(&full[c].ekf, 1.0f);
+        SOH_Init(&full[c].soh, NOMINAL_CAPACITY);
+        Safety_Init(&full[c].fsm);
+        T[c] = 25.0f;
+    }
+    Fleet_Store *store = Fleet_Create(mem, store_bytes, N_CELLS, 1.0f);
+
+    double t_full = 0.0, t_packed = 0.0;
+
+    for (uint32_t k = 1; k < N_STEPS; k++) {
+        const float dt = test_time[k] - test_time[k - 1];
+        for (uint32_t c = 0; c < N_CELLS; c++) {
+            I[c] = test_current[k] * (1.0f - 0.2f * (float)(c % 8u) / 8.0f);
+            V[c] = test_v_meas[k];
+        }
+
+        double t0 = now_s();
+        for (uint32_t c = 0; c < N_CELLS; c++) {
+            Fleet_Cell *w = &full[c];
+            BMS_ECM_Step(&w->bms, I[c], dt);
+            EKF_Predict(&w->ekf, I[c], dt);
+            EKF_Update(&w->ekf, V[c], I[c]);
+            SOH_Update(&w->soh, I[c], V[c], dt);
+            Safety_Check(&w->fsm, V[c], I[c], T[c], w->ekf.soc, dt);
+        }
+        double t1 = now_s();
+        Fleet_Step(store, 0u, N_CELLS, I, V, T, dt, soc);
+        double t2 = now_s();
+
+        t_full += t1 - t0;
+        t_packed += t2 - t1;
+    }
+
+    float max_diff = 0.0f;
+    for (uint32_t c = 0; c < N_CELLS; c++) {
+        const float d = fabsf(soc[c] - full[c].ekf.soc);
+        if (d > max_diff) max_diff = d;
+    }
+
+    const double cell_steps = (double)N_CELLS * (double)(N_STEPS - 1u);
+    printf("\nLayout\t\tBytes/cell\tns/cell-step\n");
+    printf("Full structs\t%u\t\t%.1f\n", (unsigned)sizeof(Fleet_Cell), t_full * 1e9 / cell_steps);
+    printf("Packed store\t%u\t\t%.1f\n", (unsigned)Fleet_BytesPerCell(), t_packed * 1e9 / cell_steps);
+    printf("Memory saving: %.1fx, throughput cost: %.2fx\n",
+           (double)sizeof(Fleet_Cell) / (double)Fleet_BytesPerCell(),
+           (t_full > 0.0) ? t_packed / t_full : 0.0);
+    printf("Max SOC difference packed vs full: %.2e\n", max_diff);
+
+    /* Memory-mapped persistence */
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/bms_fleet_bench_%d.bin", (int)getpid());
+    unlink(path);
+
+    Fleet_Mapping map;
+    double t0 = now_s();
+    Fleet_Store *mapped = Fleet_MapFile(path, N_CELLS, 1.0f, &map);
+    double t1 = now_s();
+    if (mapped != NULL) {
+        Fleet_Step(mapped, 0u, N_CELLS, I, V, T, 1.0f, NULL);
+        double t2 = now_s();
+        Fleet_Sync(&map);
+        double t3 = now_s();
+        printf("\nMapped store: %.1f MB, create %.1f ms, step %.1f ms, msync %.1f ms\n",
+               (double)map.bytes / 1e6, (t1 - t0) * 1e3, (t2 - t1) * 1e3, (t3 - t2) * 1e3);
+        Fleet_Unmap(&map);
+    } else {
+        printf("\nMapped store: could not map %s\n", path);
+    }
+    unlink(path);
+
+    free(full); free(mem);
+    free(I); free(V); free(T); free(soc);
+    return 0;
+}
@@ -0,0 +1,116 @@
+
+/*
+ * bench_forecast.c - Forecasts per second per core
+ *
+ * Runs a set of dispatch-style load scenarios through BMS_Forecast_Run
+ * and compares with a scalar loop stepping BMS_ECM_Step per scenario.
+ * Also times the closed-form state-of-power query.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include "bms_config.h"
+#include "bms_model.h"
+#include "bms_forecast.h"
+
+#define N_SCEN   (1024u)
+#define N_STEPS  (600u)      /* 10 min at 1 s */
+#define N_REPS   (20u)
+#define N_SOP    (1000000u)
+
+static double cpu_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main()
+{
+    printf("========================================\n");
+    printf("FORECAST BENCHMARK (%u scenarios x %u steps)\n", N_SCEN, N_STEPS);
+    printf("========================================\n");
+
+    float *cur = malloc((size_t)N_SCEN * N_STEPS * sizeof(float));
+    float *tte = malloc(N_SCEN * sizeof(float));
+    float *tte_ref = malloc(N_SCEN * sizeof(float));
+    if (!cur || !tte || !tte_ref) {
+        printf("allocation failed\n");
+        return 1;
+    }
+
+    /* Candidate dispatch profiles: base load plus square-wave pulses */
+    for (uint32_t s = 0; s < N_SCEN; s++) {
+        const float base = -0.1f - 1.2f * (float)(s % 32u) / 31.0f;
+        const uint32_t period = 10u + 5u * (s / 32u);
+        for (uint32_t k = 0; k < N_STEPS; k++) {
+            cur[(size_t)k * N_SCEN + s] = ((k / period) % 2u) ? base * 1.5f : base;
+        }
+    }
+
+    EKF_State ekf;
+    EKF_Init(&ekf, 0.08f);
+
+    BMS_Forecast_Scenarios sc = { cur, N_SCEN, N_STEPS, N_SCEN, DT_CORE };
+    BMS_Forecast_Output out = { tte, NULL, NULL };
+
+    double t0 = cpu_s();
+    for (uint32_t r = 0; r < N_REPS; r++) BMS_Forecast_Run(&ekf, &sc, &out);
+    const double t_lanes = (cpu_s() - t0) / N_REPS;
+
+    /* Scalar reference: one scenario at a time through the ECM step */
+    t0 = cpu_s();
+    for (uint32_t r = 0; r < N_REPS; r++) {
+        for (uint32_t s = 0; s < N_SCEN; s++) {
+            BMS_State st;
+            BMS_Init(&st);
+            st.soc = ekf.soc;
+            st.v1 = ekf.v1;
+            tte_ref[s] = INFINITY;
+            for (uint32_t k = 0; k < N_STEPS; k++) {
+                BMS_ECM_Step(&st, cur[(size_t)k * N_SCEN + s], DT_CORE);
+                if (st.v_terminal < VOLTAGE_MIN || st.soc <= SOC_MIN) {
+                    tte_ref[s] = (float)(k + 1u) * DT_CORE;
+                    break;
+                }
+            }
+        }
+    }
+    const double t_scalar = (cpu_s() - t0) / N_REPS;
+
+    uint32_t n_empty = 0u, agree = 0u;
+    for (uint32_t s = 0; s < N_SCEN; s++) {
+        if (isinf(tte[s]) == isinf(tte_ref[s]) &&
+            (isinf(tte[s]) || fabsf(tte[s] - tte_ref[s]) <= DT_CORE)) agree++;
+        if (!isinf(tte[s])) n_empty++;
+    }
+
+    const double lane_steps = (double)N_SCEN * N_STEPS;
+    printf("\nPath\t\tForecasts/s\tns/scenario-step\n");
+    printf("SoA lanes\t%.0f\t\t%.2f\n", N_SCEN / t_lanes, t_lanes * 1e9 / lane_steps);
+    printf("Scalar ECM\t%.0f\t\t%.2f\n", N_SCEN / t_scalar, t_scalar * 1e9 / lane_steps);
+    printf("Speedup: %.1fx, %u/%u empty within horizon, %u/%u agree with scalar\n",
+           (t_lanes > 0.0) ? t_scalar / t_lanes : 0.0, n_empty, N_SCEN, agree, N_SCEN);
+
+    /* Closed-form SOP over 10/30/60 s */
+    BMS_SOP_Result sop[3];
+    volatile float sink = 0.0f;
+    t0 = cpu_s();
+    for (uint32_t i = 0; i < N_SOP; i++) {
+        ekf.soc = 0.05f + 0.9f * (float)(i & 1023u) / 1023.0f;
+        BMS_Forecast_SOPDefault(&ekf, sop);
+        sink += sop[2].power_W;
+    }
+    const double t_sop = cpu_s() - t0;
+    (void)sink;
+    printf("\nSOP (3 horizons): %.0f queries/s, %.1f ns/query\n", N_SOP / t_sop, t_sop * 1e9 / N_SOP);
+
+    free(cur); free(tte); free(tte_ref);
+    return 0;
+}
@@ -0,0 +1,36 @@
+#!/bin/bash
+# Import benchmark: synthetic NASA-style charge/discharge CSVs through
+# bms_import, single-threaded and across all cores.
+#
+#   bench_import.sh [BIN_DIR]
+
+BIN=${1:-..}
+FILES=64
+ROWS=50000
+DIR=/tmp/bms_import_bench_$$
+
+mkdir -p "$DIR/csv" "$DIR/out"
+
+for f in $(seq 1 $FILES); do
+    awk -v rows=$ROWS -v seed=$f 'BEGIN {
+        srand(seed)
+        print "Voltage_measured,Current_measured,Temperature_measured,Current_load,Voltage_load,Time"
+        t = 0.0
+        for (k = 0; k < rows; k++) {
+            t += 0.8 + 0.4 * rand()
+            printf "%.9f,%.9f,%.6f,%.4f,%.3f,%.3f\n",
+                4.2 - 1.2 * k / rows + 0.001 * rand(), -2.0 + 0.01 * rand(),
+                24.0 + 8.0 * k / rows, 2.0, 3.0, t
+        }
+    }' > "$DIR/csv/B$(printf %04d $f)_discharge.csv"
+done
+
+echo ""
+echo "--- 1 thread ---"
+"$BIN/bms_import.exe" -j 1 -o "$DIR/out" "$DIR"/csv/*.csv
+
+echo ""
+echo "--- $(nproc) threads ---"
+"$BIN/bms_import.exe" -j "$(nproc)" -o "$DIR/out" "$DIR"/csv/*.csv
+
+rm -rf "$DIR"
@@ -0,0 +1,33 @@
+#!/bin/bash
+# Ingest daemon benchmark: local generator -> bms_ingestd over a Unix
+# datagram socket (backpressured, lossless) and over UDP loopback.
+#
+#   bench_ingest.sh [BIN_DIR]
+
+BIN=${1:-..}
+PACKS=16
+CELLS=96
+TICKS=2000
+
+run() {
+    local transport=$1
+    local endpoint=$2
+    local rate=$3
+
+    echo ""
+    echo "--- $transport, rate=${rate} ticks/s ---"
+    "$BIN/bms_ingestd.exe" --$transport "$endpoint" --packs $PACKS --cells $CELLS &
+    local pid=$!
+    sleep 0.3
+    "$BIN/bms_framegen.exe" --$transport "$endpoint" --packs $PACKS --cells $CELLS \
+        --ticks $TICKS --rate $rate
+    wait $pid
+}
+
+SOCK=/tmp/bms_ingest_bench_$$.sock
+
+# Paced: latency at a realistic tick rate, then saturation throughput
+run unix "$SOCK" 200
+run unix "$SOCK" 0
+run udp 47011 200
+run udp 47011 0
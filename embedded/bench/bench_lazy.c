@@ -0,0 +1,189 @@
+
+/*
+ * bench_lazy.c - CPU and accuracy of lazy vs always-on stepping
+ *
+ * Generates 24 h stationary-storage duty cycles at DT_CORE from a truth
+ * ECM with sensor noise, then runs every cell through always-on
+ * estimator stepping and through BMS_Lazy_Step. Reports CPU time per
+ * cell-hour, the share of samples deferred and the SOC difference.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include "bms_config.h"
+#include "bms_lazy.h"
+
+#define N_CELLS   (16u)
+#define N_SAMPLES (86400u)   /* 24 h at 1 s */
+
+typedef enum {
+    PROFILE_STORAGE_DAY = 0,   /* one charge, one evening discharge, long rests */
+    PROFILE_PEAK_SHAVING,      /* short discharge pulses, overnight charge */
+    PROFILE_FREQ_RESPONSE,     /* piecewise-constant setpoint every 2-10 min */
+    PROFILE_COUNT
+} Profile_t;
+
+static const char *const profile_names[PROFILE_COUNT] = {
+    "storage day", "peak shaving", "freq response"
+};
+
+static double cpu_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Deterministic per-cell noise */
+static uint32_t rng_state;
+static float noise(float sigma)
+{
+    float s = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        rng_state = rng_state * 1664525u + 1013904223u;
+        s += (float)(rng_state >> 8) / 16777216.0f - 0.5f;
+    }
+    return s * sigma * 1.732f;   /* var of sum of 4 U(-.5,.5) = 1/3 */
+}
+
+static float setpoint(Profile_t p, uint32_t k)
+{
+    const float h = (float)k / 3600.0f;
+
+    switch (p) {
+        case PROFILE_STORAGE_DAY:
+            if (h >= 10.0f && h < 12.0f) return 0.6f;
+            if (h >= 18.0f && h < 19.5f) return -0.8f;
+            return 0.0f;
+
+        case PROFILE_PEAK_SHAVING:
+            if (h < 4.0f) return 0.3f;
+            if (fmodf(h, 3.0f) < 0.5f && h >= 6.0f) return -0.7f;
+            return 0.0f;
+
+        case PROFILE_FREQ_RESPONSE:
+        default: {
+            /* New level every 120-600 s, small symmetric around zero */
+            static float level = 0.0f;
+            static uint32_t next = 0u;
+            if (k == 0u) next = 0u;
+            if (k >= next) {
+                rng_state = rng_state * 1664525u + 1013904223u;
+                level = 0.4f * ((float)(rng_state >> 8) / 16777216.0f - 0.5f);
+                rng_state = rng_state * 1664525u + 1013904223u;
+                next = k + 120u + (rng_state >> 8) % 480u;
+            }
+            return level;
+        }
+    }
+}
+
+int main()
+{
+    printf("========================================\n");
+    printf("LAZY UPDATE BENCHMARK (%u cells x 24 h)\n", N_CELLS);
+    printf("========================================\n");
+
+    float *I = malloc((size_t)N_CELLS * N_SAMPLES * sizeof(float));
+    float *V = malloc((size_t)N_CELLS * N_SAMPLES * sizeof(float));
+    float *soc_on = malloc((size_t)N_SAMPLES * sizeof(float));
+    BMS_Lazy_Cell *cells = malloc(N_CELLS * sizeof(BMS_Lazy_Cell));
+    if (!I || !V || !soc_on || !cells) {
+        printf("allocation failed\n");
+        return 1;
+    }
+
+    BMS_Lazy_Config cfg;
+    BMS_Lazy_DefaultConfig(&cfg);
+
+    printf("\nProfile\t\tAlways-on\tLazy\t\tSpeedup\tDeferred\tmax|dSOC|\tRMS dSOC\n");
+    printf("\t\tus/cell-h\tus/cell-h\n");
+
+    for (int p = 0; p < PROFILE_COUNT; p++) {
+        /* Truth ECM + sensor noise */
+        for (uint32_t c = 0; c < N_CELLS; c++) {
+            rng_state = 0x9E3779B9u * (c + 1u) + (uint32_t)p;
+            BMS_State truth;
+            BMS_Init(&truth);
+            truth.soc = 0.3f;
+            for (uint32_t k = 0; k < N_SAMPLES; k++) {
+                const float i_true = setpoint((Profile_t)p, k);
+                BMS_ECM_Step(&truth, i_true, DT_CORE);
+                I[(size_t)c * N_SAMPLES + k] = i_true + noise(0.005f);
+                V[(size_t)c * N_SAMPLES + k] = truth.v_terminal + noise(0.001f);
+            }
+        }
+
+        /* Always-on */
+        double t0 = cpu_s();
+        for (uint32_t c = 0; c < N_CELLS; c++) {
+            BMS_Lazy_Cell *cell = &cells[c];
+            BMS_Lazy_Init(cell, 0.3f);
+            const float *Ic = I + (size_t)c * N_SAMPLES;
+            const float *Vc = V + (size_t)c * N_SAMPLES;
+            for (uint32_t k = 0; k < N_SAMPLES; k++) {
+                BMS_ECM_Step(&cell->bms, Ic[k], DT_CORE);
+                EKF_Predict(&cell->ekf, Ic[k], DT_CORE);
+                EKF_Update(&cell->ekf, Vc[k], Ic[k]);
+                SOH_Update(&cell->soh, Ic[k], Vc[k], DT_CORE);
+                Safety_Check(&cell->fsm, Vc[k], Ic[k], 25.0f, cell->ekf.soc, DT_CORE);
+            }
+        }
+        const double t_on = cpu_s() - t0;
+
+        /* Lazy */
+        t0 = cpu_s();
+        for (uint32_t c = 0; c < N_CELLS; c++) {
+            BMS_Lazy_Cell *cell = &cells[c];
+            BMS_Lazy_Init(cell, 0.3f);
+            const float *Ic = I + (size_t)c * N_SAMPLES;
+            const float *Vc = V + (size_t)c * N_SAMPLES;
+            for (uint32_t k = 0; k < N_SAMPLES; k++) {
+                BMS_Lazy_Step(cell, &cfg, Ic[k], Vc[k], 25.0f, DT_CORE);
+            }
+            BMS_Lazy_Flush(cell);
+        }
+        const double t_lazy = cpu_s() - t0;
+
+        /* Accuracy: replay one cell, compare whenever lazy has caught up */
+        BMS_Lazy_Cell on, lazy;
+        BMS_Lazy_Init(&on, 0.3f);
+        BMS_Lazy_Init(&lazy, 0.3f);
+        double sq = 0.0;
+        uint32_t n_cmp = 0u;
+        float max_d = 0.0f;
+        uint64_t deferred = 0u;
+        for (uint32_t k = 0; k < N_SAMPLES; k++) {
+            EKF_Predict(&on.ekf, I[k], DT_CORE);
+            EKF_Update(&on.ekf, V[k], I[k]);
+            soc_on[k] = on.ekf.soc;
+
+            BMS_Lazy_Step(&lazy, &cfg, I[k], V[k], 25.0f, DT_CORE);
+            if (k == N_SAMPLES - 1u) BMS_Lazy_Flush(&lazy);
+            if (lazy.win_n != 0u) continue;
+
+            const float d = fabsf(lazy.ekf.soc - soc_on[k]);
+            if (d > max_d) max_d = d;
+            sq += (double)d * (double)d;
+            n_cmp++;
+        }
+        for (uint32_t c = 0; c < N_CELLS; c++) deferred += cells[c].steps_deferred;
+
+        const double cell_hours = (double)N_CELLS * (double)N_SAMPLES * DT_CORE / 3600.0;
+        printf("%-14s\t%.1f\t\t%.1f\t\t%.1fx\t%.1f%%\t\t%.2e\t%.2e\n",
+               profile_names[p],
+               t_on * 1e6 / cell_hours, t_lazy * 1e6 / cell_hours,
+               (t_lazy > 0.0) ? t_on / t_lazy : 0.0,
+               100.0 * (double)deferred / ((double)N_CELLS * N_SAMPLES),
+               max_d, sqrt(sq / (double)(n_cmp ? n_cmp : 1u)));
+    }
+
+    free(I); free(V); free(soc_on); free(cells);
+    return 0;
+}
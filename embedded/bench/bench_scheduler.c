@@ -0,0 +1,179 @@
+
+/*
+ * bench_scheduler.c - Pack-scale deadline check for the multi-rate scheduler
+ *
+ * Runs the standard BMS tasks for increasing pack sizes with a real
+ * monotonic clock. A calibration pass without shedding measures each
+ * task's execution time; budgets are its 99th percentile plus margin.
+ * The measured pass then reports per-task WCET against those budgets,
+ * overruns, shed activations, the budgeted headroom left in a tick and
+ * the observed tick time against the tick budget.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bms_config.h"
+#include "bms_scheduler.h"
+#include "bms_tasks.h"
+#include "test_vectors.h"
+
+#define N_TICKS        (20000u)
+#define N_CAL_TICKS    (2000u)     /* calibration pass, shedding off */
+#define TICK_BUDGET_US (2000u)     /* CPU allotted to BMS per base tick */
+#define SOH_EVERY      (100u)      /* stand-in cycle end: trigger SOH */
+#define BUDGET_MARGIN  (4u)        /* budget = p99 + p99 / BUDGET_MARGIN + 2 us */
+
+static uint32_t samples[BMS_TASK_COUNT][N_TICKS];
+
+static uint32_t host_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u);
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    const uint32_t x = *(const uint32_t *)a;
+    const uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Percentile (0..100) of n samples, sorts in place */
+static uint32_t percentile(uint32_t *v, uint32_t n, uint32_t pct)
+{
+    if (n == 0u) return 0u;
+    qsort(v, n, sizeof(v[0]), cmp_u32);
+    return v[((uint64_t)(n - 1u) * pct) / 100u];
+}
+
+/*
+  Run n_ticks ticks, feeding the test vectors and triggering SOH every
+  SOH_EVERY ticks. Each task's execution time per run goes to samples[]
+  (n_runs[] entries), and the tick time to tick_us[] when given.
+*/
+static void run_ticks(Scheduler *sched, const int *ids, uint32_t n_ticks, uint32_t n_cells,
+                      float *current, float *voltage, uint32_t *n_runs, uint32_t *tick_us)
+{
+    for (int i = 0; i < BMS_TASK_COUNT; i++) n_runs[i] = 0u;
+
+    for (uint32_t k = 0; k < n_ticks; k++) {
+        const uint32_t s = k % NUM_TEST_SAMPLES;
+        for (uint32_t c = 0; c < n_cells; c++) {
+            current[c] = test_current[s];
+            voltage[c] = test_v_meas[s];
+        }
+        if ((k % SOH_EVERY) == SOH_EVERY - 1u) Sched_Trigger(sched, ids[BMS_TASK_SOH]);
+
+        uint32_t before[BMS_TASK_COUNT];
+        for (int i = 0; i < BMS_TASK_COUNT; i++) before[i] = Sched_GetTask(sched, ids[i])->run_count;
+
+        const uint32_t us = Sched_RunTick(sched);
+        if (tick_us != NULL) tick_us[k] = us;
+
+        for (int i = 0; i < BMS_TASK_COUNT; i++) {
+            const Sched_Task *t = Sched_GetTask(sched, ids[i]);
+            if (t->run_count != before[i]) samples[i][n_runs[i]++] = t->last_us;
+        }
+    }
+}
+
+static void run_pack(uint32_t n_cells)
+{
+    BMS_State  *bms = malloc(n_cells * sizeof(*bms));
+    EKF_State  *ekf = malloc(n_cells * sizeof(*ekf));
+    SOH_State  *soh = malloc(n_cells * sizeof(*soh));
+    Safety_FSM *fsm = malloc(n_cells * sizeof(*fsm));
+    BMS_Cell_Acc *acc = calloc(n_cells, sizeof(*acc));
+    float *current = malloc(n_cells * sizeof(float));
+    float *voltage = malloc(n_cells * sizeof(float));
+    float *temp    = malloc(n_cells * sizeof(float));
+
+    if (!bms || !ekf || !soh || !fsm || !acc || !current || !voltage || !temp) {
+        printf("allocation failed for %u cells\n", n_cells);
+        exit(1);
+    }
+
+    for (uint32_t c = 0; c < n_cells; c++) {
+        BMS_Init(&bms[c]);
+        EKF_Init(&ekf[c], 1.0f);
+        SOH_Init(&soh[c], NOMINAL_CAPACITY);
+        Safety_Init(&fsm[c]);
+        temp[c] = 25.0f;
+    }
+
+    BMS_Pack pack = { n_cells, bms, ekf, soh, fsm, acc, current, voltage, temp, SCHED_TICK_DT, NULL, -1 };
+
+    BMS_Task_Config cfg;
+    BMS_Tasks_DefaultConfig(&cfg);
+    int ids[BMS_TASK_COUNT];
+    uint32_t n_runs[BMS_TASK_COUNT];
+    static uint32_t tick_us[N_TICKS];
+
+    /* Calibration: no tick budget, so nothing is shed */
+    Scheduler cal;
+    Sched_Init(&cal, host_now_us, 0u);
+    BMS_Tasks_Register(&cal, &pack, &cfg, ids);
+    run_ticks(&cal, ids, N_CAL_TICKS, n_cells, current, voltage, n_runs, NULL);
+
+    /* Worst case per tick if every task were due: sum of budgets */
+    uint32_t budget_sum = 0u;
+    for (int i = 0; i < BMS_TASK_COUNT; i++) {
+        const uint32_t p99 = percentile(samples[i], n_runs[i], 99u);
+        cfg.budget_us[i] = p99 + p99 / BUDGET_MARGIN + 2u;
+        budget_sum += cfg.budget_us[i];
+    }
+
+    /* Measured pass, restarted from the initial cell state */
+    for (uint32_t c = 0; c < n_cells; c++) {
+        BMS_Init(&bms[c]);
+        EKF_Init(&ekf[c], 1.0f);
+        SOH_Init(&soh[c], NOMINAL_CAPACITY);
+        Safety_Init(&fsm[c]);
+    }
+    memset(acc, 0, n_cells * sizeof(*acc));
+
+    Scheduler sched;
+    Sched_Init(&sched, host_now_us, TICK_BUDGET_US);
+    BMS_Tasks_Register(&sched, &pack, &cfg, ids);
+    run_ticks(&sched, ids, N_TICKS, n_cells, current, voltage, n_runs, tick_us);
+
+    printf("\n%u cells, %u ticks, tick budget %u us\n", n_cells, N_TICKS, TICK_BUDGET_US);
+    printf("Task\tBudget\tp99\tWCET\tRuns\tOverrun\tShed\n");
+    for (int i = 0; i < BMS_TASK_COUNT; i++) {
+        const Sched_Task *t = Sched_GetTask(&sched, ids[i]);
+        printf("%s\t%u\t%u\t%u\t%u\t%u\t%u\n",
+               t->name, t->budget_us, percentile(samples[i], n_runs[i], 99u), t->wcet_us,
+               t->run_count, t->overrun_count, t->shed_count);
+    }
+
+    const uint32_t tick_p99 = percentile(tick_us, N_TICKS, 99u);
+    printf("Budgeted headroom: %d us (all tasks due: %u us)\n",
+           (int)TICK_BUDGET_US - (int)budget_sum, budget_sum);
+    printf("Tick p99: %u us (%s), WCET: %u us, tick overruns: %u\n",
+           tick_p99, (tick_p99 <= TICK_BUDGET_US) ? "meets deadline" : "MISSES deadline",
+           sched.tick_wcet_us, sched.tick_overruns);
+
+    free(bms); free(ekf); free(soh); free(fsm); free(acc);
+    free(current); free(voltage); free(temp);
+}
+
+int main()
+{
+    printf("========================================\n");
+    printf("SCHEDULER PACK-SCALE BENCHMARK\n");
+    printf("========================================\n");
+
+    static const uint32_t sizes[] = { 12u, 96u, 384u, 1536u, 6144u };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        run_pack(sizes[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+#ifndef BMS_BATCH_H_
+#define BMS_BATCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>  /* for size_t */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  Batch C ABI for host-side analytics (numpy / Arrow callers).
+
+  Runs ECM -> EKF predict/update -> SOH -> safety for many cells over
+  caller-owned columnar buffers. No internal allocation, no copies:
+  the caller provides the state memory and every input/output column.
+
+  Column layout (all columns, inputs and outputs):
+    element (cell c, sample k) lives at col[c * ld + k]
+  i.e. one contiguous time series per cell, as in a C-contiguous
+  numpy array of shape (n_cells, ld). Use ld = n_samples for a dense
+  block.
+
+  Timestamps are double so absolute (e.g. Unix epoch) seconds keep
+  sub-millisecond resolution. The first sample a cell ever sees only
+  seeds its clock (dt = 0); later samples use dt = t[k] - t[k-1],
+  across Run calls.
+
+  Sign convention as BMS_ECM_Step: discharge current < 0.
+*/
+
+#if defined(_WIN32) && defined(BMS_BUILD_SHARED)
+#define BMS_API __declspec(dllexport)
+#elif defined(__GNUC__)
+#define BMS_API __attribute__((visibility("default")))
+#else
+#define BMS_API
+#endif
+
+/* Opaque per-pack handle, lives inside caller memory */
+typedef struct BMS_Batch BMS_Batch;
+
+/* Input columns (all required except valid) */
+typedef struct {
+    const double *time_s;      /* sample timestamp (s), dt = t[k] - t[k-1] */
+    const float *current_A;    /* cell current (A) */
+    const float *voltage_V;    /* measured terminal voltage (V) */
+    const float *temp_C;       /* cell temperature (degC) */
+    const uint8_t *valid;      /* optional: 0 = sample missing, skip it and
+                                  let the next valid one span the gap */
+} BMS_Batch_Input;
+
+/* Output columns (any may be NULL to skip) */
+typedef struct {
+    float   *soc;              /* EKF SOC estimate */
+    float   *v1;               /* EKF RC voltage estimate (V) */
+    float   *v_pred;           /* EKF predicted terminal voltage (V) */
+    float   *innovation;       /* v_measured - v_pred (V) */
+    uint8_t *fault_flags;      /* Fault_Flag_t bitmask after Safety_Check */
+} BMS_Batch_Output;
+
+/* Bytes of state memory needed for n_cells (mem must be 8-byte aligned) */
+BMS_API size_t BMS_Batch_StateSize(uint32_t n_cells);
+
+/*
+  Place a handle in caller memory and initialize all cells.
+  Returns NULL if mem is NULL, misaligned or smaller than
+  BMS_Batch_StateSize(n_cells).
+*/
+BMS_API BMS_Batch* BMS_Batch_Init(void *mem, size_t mem_bytes,
+                                  uint32_t n_cells, float init_soc);
+
+/* Re-initialize one cell (e.g. after cell replacement) */
+BMS_API void BMS_Batch_ResetCell(BMS_Batch *batch, uint32_t cell, float init_soc);
+
+/* Number of cells in handle (0 for NULL) */
+BMS_API uint32_t BMS_Batch_NumCells(const BMS_Batch *batch);
+
+/*
+  Process n_samples per cell for all cells.
+  Returns number of samples processed per cell (0 on bad arguments).
+*/
+BMS_API size_t BMS_Batch_Run(BMS_Batch *batch,
+                             const BMS_Batch_Input *in,
+                             BMS_Batch_Output *out,
+                             size_t n_samples,
+                             size_t ld);
+
+/* Per-cell SOH percentage (0..100) */
+BMS_API float BMS_Batch_GetSOH(const BMS_Batch *batch, uint32_t cell);
+
+/* Per-cell safety state (BMS_State_t) */
+BMS_API int BMS_Batch_GetSafetyState(const BMS_Batch *batch, uint32_t cell);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
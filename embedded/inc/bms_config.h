@@ -27,10 +27,52 @@
 #define TEMP_MIN         (-10.0f)
 #define TEMP_MAX         (45.0f)
 
+/* ============= SAFETY DEBOUNCE ============= */
+/* Condition must persist this long before a fault sets / clears (ms) */
+#define SAFETY_SET_MS_VOLTAGE    (200u)
+#define SAFETY_CLR_MS_VOLTAGE    (1000u)
+#define SAFETY_SET_MS_CURRENT    (50u)
+#define SAFETY_CLR_MS_CURRENT    (500u)
+#define SAFETY_SET_MS_TEMP       (1000u)
+#define SAFETY_CLR_MS_TEMP       (5000u)
+#define SAFETY_SET_MS_SOC        (1000u)
+#define SAFETY_CLR_MS_SOC        (5000u)
+
+/* Hysteresis: value must return inside limit by this margin to clear */
+#define SAFETY_HYST_VOLTAGE      (0.05f)
+#define SAFETY_HYST_CURRENT      (0.10f)
+#define SAFETY_HYST_TEMP         (2.0f)
+#define SAFETY_HYST_SOC          (0.01f)
+
 /* ============= SOH PARAMETERS ============= */
 #define EOL_CAPACITY     (1.328f)
 #define SOH_UPDATE_CYCLES (20u)
 
+/* ============= SCHEDULER ============= */
+#define SCHED_MAX_TASKS       (8u)
+#define SCHED_TICK_DT         (DT_CORE)   /* Base tick period (s) */
+#define SCHED_RATE_SAFETY     (1u)        /* Ticks between runs */
+#define SCHED_RATE_ECM        (1u)
+#define SCHED_RATE_EKF        (5u)
+#define SCHED_RATE_SOH        (0u)        /* 0 = run on Sched_Trigger only (cycle end) */
+
+/* ============= LAZY UPDATE MODE ============= */
+/* Quiet window: signals stay within these bands of the window's first sample */
+#define LAZY_I_BAND           (0.02f)     /* A */
+#define LAZY_V_BAND           (0.01f)     /* V */
+#define LAZY_T_BAND           (1.0f)      /* degC */
+#define LAZY_MAX_WINDOW_S     (60.0f)     /* EKF update at least this often (s) */
+
+/* ============= FORECAST ============= */
+#define FORECAST_LANES        (64u)       /* scenarios advanced together */
+#define FORECAST_HORIZON_1_S  (10.0f)     /* state-of-power horizons (s) */
+#define FORECAST_HORIZON_2_S  (30.0f)
+#define FORECAST_HORIZON_3_S  (60.0f)
+
+/* ============= TELEMETRY INGEST ============= */
+#define INGEST_MAX_CELLS_PER_PACK (256u)
+#define INGEST_LAT_BUCKETS        (20000u)   /* 1 us latency histogram bins */
+
 /* Use absolute current for IR drop */
 #define ECM_USE_ABS_CURRENT (1u)
 
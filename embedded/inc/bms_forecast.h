@@ -0,0 +1,91 @@
+#ifndef BMS_FORECAST_H_
+#define BMS_FORECAST_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>  /* for size_t */
+
+#include "soc_estimator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  Forward simulation of the ECM from the current EKF estimate.
+
+  Uses the same model as EKF_Predict / EKF_Update:
+    soc' = I / (NOMINAL_CAPACITY * 3600)
+    v1   relaxes to |I| * R1 with tau = R1 * C1 (closed form per step)
+    V    = OCV(soc) - v1 - |I| * R0
+  Sign convention as BMS_ECM_Step: discharge current < 0.
+
+  The cell is "empty" when V drops below VOLTAGE_MIN or SOC reaches
+  SOC_MIN, whichever comes first. With the default parameters
+  OCV(SOC_MIN) - CURRENT_MAX * (R0 + R1) stays above VOLTAGE_MIN, so
+  SOC normally binds first.
+*/
+
+/*
+  Load scenarios, step-major so one step of all scenarios is contiguous:
+    current of scenario s during step k = current_A[k * ld + s]
+  Each step holds its current for dt_s.
+*/
+typedef struct {
+    const float *current_A;
+    uint32_t     n_scenarios;
+    uint32_t     n_steps;
+    size_t       ld;            /* >= n_scenarios */
+    float        dt_s;
+} BMS_Forecast_Scenarios;
+
+/* Per-scenario outputs (any may be NULL) */
+typedef struct {
+    float *tte_s;       /* time to empty (s), interpolated within the step;
+                           INFINITY if not empty within n_steps * dt_s */
+    float *v_min;       /* lowest terminal voltage until empty / end (V) */
+    float *soc_end;     /* SOC at the end of the profile */
+} BMS_Forecast_Output;
+
+/*
+  Run all scenarios from the EKF state. Scenarios are advanced
+  FORECAST_LANES at a time in struct-of-arrays form.
+  Returns the number of scenarios processed (0 on bad arguments).
+*/
+size_t BMS_Forecast_Run(const EKF_State *ekf,
+                        const BMS_Forecast_Scenarios *sc,
+                        BMS_Forecast_Output *out);
+
+/* What bounds a state-of-power result */
+typedef enum {
+    SOP_LIMIT_CURRENT = 0,      /* CURRENT_MAX */
+    SOP_LIMIT_VOLTAGE,          /* VOLTAGE_MIN reached within the horizon */
+    SOP_LIMIT_SOC               /* cell would be empty within the horizon */
+} SOP_Limit_t;
+
+typedef struct {
+    float       horizon_s;
+    float       current_A;      /* max constant discharge current (A, >= 0) */
+    float       power_W;        /* current_A * lowest voltage over horizon */
+    float       v_min;          /* lowest terminal voltage at that current (V) */
+    SOP_Limit_t limit;
+} BMS_SOP_Result;
+
+/*
+  Peak sustainable discharge power for each horizon: the largest constant
+  current that keeps V >= VOLTAGE_MIN, |I| <= CURRENT_MAX and
+  SOC >= SOC_MIN for the whole horizon, solved in closed form.
+*/
+void BMS_Forecast_SOP(const EKF_State *ekf,
+                      const float *horizons_s,
+                      uint32_t n_horizons,
+                      BMS_SOP_Result *out);
+
+/* SOP at FORECAST_HORIZON_1/2/3_S */
+void BMS_Forecast_SOPDefault(const EKF_State *ekf, BMS_SOP_Result out[3]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
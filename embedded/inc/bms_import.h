@@ -0,0 +1,135 @@
+#ifndef BMS_IMPORT_H_
+#define BMS_IMPORT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>  /* for size_t */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  Native import / clean / resample for raw NASA PCoE cycle CSVs.
+  C counterpart of matlab/01_import_clean/import_nasa.m:
+
+    - columns are detected once per file from the header, with the same
+      flexible names and priority as import_nasa.m
+    - rows with any empty or NaN field are dropped (rmmissing)
+    - rows whose time does not increase are dropped (import_nasa.m sorts;
+      NASA recordings are already monotonic)
+    - signals are linearly interpolated onto floor(t0):dt:ceil(tN),
+      extrapolating at both ends like interp1(..., 'linear', 'extrap')
+    - charge current is made positive, discharge current negative
+
+  All of this happens in one streaming pass over the CSV text.
+*/
+
+typedef enum {
+    BMS_CYCLE_CHARGE = 0,
+    BMS_CYCLE_DISCHARGE,
+    BMS_CYCLE_IMPEDANCE,
+    BMS_CYCLE_AUTO          /* infer from header (Current_charge / Current_load) */
+} BMS_Cycle_Type;
+
+typedef enum {
+    IMPORT_OK = 0,
+    IMPORT_ERR_NO_TIME,
+    IMPORT_ERR_NO_VOLTAGE,
+    IMPORT_ERR_NO_CURRENT,
+    IMPORT_ERR_TOO_FEW,     /* fewer than 2 valid rows */
+    IMPORT_ERR_NOMEM
+} BMS_Import_Status_t;
+
+/*
+  Resampled cycle. Column buffers are owned by the result and grown on
+  demand; reuse one result across files to avoid reallocation.
+*/
+typedef struct {
+    float   *V;
+    float   *I;
+    float   *T;
+    size_t   n;             /* resampled samples */
+    size_t   cap;           /* allocated samples per column */
+
+    double   t_start_s;
+    float    dt_s;
+    BMS_Cycle_Type type;    /* resolved (never AUTO) */
+
+    /* Detected column indices (-1 = absent, default used) */
+    int      col_time, col_voltage, col_current, col_temp;
+
+    /* Row accounting */
+    uint32_t rows_raw;
+    uint32_t rows_valid;
+    uint32_t rows_missing;  /* dropped: empty / NaN field */
+    uint32_t rows_order;    /* dropped: time not increasing */
+} BMS_Import_Result;
+
+/* Zero a result before first use */
+void BMS_Import_ResultInit(BMS_Import_Result *res);
+
+/* Release column buffers */
+void BMS_Import_ResultFree(BMS_Import_Result *res);
+
+/* Import one CSV held in memory (e.g. mmap'd); text need not be NUL-terminated */
+BMS_Import_Status_t BMS_Import_CSV(const char *text,
+                                   size_t len,
+                                   BMS_Cycle_Type type,
+                                   float dt_s,
+                                   BMS_Import_Result *res);
+
+/* Human-readable status */
+const char* BMS_Import_StatusString(BMS_Import_Status_t status);
+
+/* ---------- Binary cycle file ---------- */
+
+/*
+  Layout (native little-endian):
+    BMS_Cycle_Header
+    float V[n_samples]
+    float I[n_samples]
+    float T[n_samples]
+  Time is implicit: t[k] = t_start_s + k * dt_s. After mmap the V/I/T
+  columns can feed BMS_Batch_Run directly, but BMS_Batch_Input also
+  needs a time_s column: the caller synthesizes it from t_start_s and
+  dt_s.
+*/
+
+#define BMS_CYCLE_MAGIC   (0x31435943u)   /* "CYC1" */
+#define BMS_CYCLE_VERSION (1u)
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t  cycle_type;    /* BMS_Cycle_Type */
+    uint8_t  reserved0;
+    uint32_t n_samples;
+    float    dt_s;
+    double   t_start_s;
+    uint32_t rows_raw;
+    uint32_t rows_valid;
+    uint32_t reserved1[2];
+} BMS_Cycle_Header;
+
+typedef struct {
+    const BMS_Cycle_Header *hdr;
+    const float *V;
+    const float *I;
+    const float *T;
+} BMS_Cycle_View;
+
+/* Total file size for n samples */
+size_t BMS_Cycle_FileSize(uint32_t n_samples);
+
+/* Fill header for a result (columns are written after it by the caller) */
+void BMS_Cycle_FillHeader(BMS_Cycle_Header *hdr, const BMS_Import_Result *res);
+
+/* Zero-copy view of a cycle file in memory. false if not a valid file */
+bool BMS_Cycle_Open(const void *mem, size_t bytes, BMS_Cycle_View *view);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
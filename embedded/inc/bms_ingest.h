@@ -0,0 +1,126 @@
+#ifndef BMS_INGEST_H_
+#define BMS_INGEST_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>  /* for size_t */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  Telemetry ingest engine.
+
+  Decodes per-cell binary frames straight into preallocated per-pack
+  column buffers and runs the batch estimator (BMS_Batch_Run) once a
+  pack has a complete tick. No allocation after Ingest_Init; the caller
+  provides all memory. Transport (sockets, epoll) lives in the daemon.
+
+  Wire frame, little-endian, INGEST_FRAME_SIZE bytes:
+    off  0  u16  magic   (INGEST_FRAME_MAGIC)
+    off  2  u8   version (INGEST_FRAME_VERSION)
+    off  3  u8   flags   (INGEST_FLAG_*)
+    off  4  u16  pack id
+    off  6  u16  cell id
+    off  8  u32  tick    (sample sequence per pack; END: frames sent)
+    off 12  f64  time (s), epoch or since start; dt comes from deltas
+    off 20  f32  current (A)
+    off 24  f32  voltage (V)
+    off 28  f32  temperature (degC)
+    off 32  u64  sender monotonic timestamp (ns), for latency
+*/
+
+#define INGEST_FRAME_SIZE     (40u)
+#define INGEST_FRAME_MAGIC    (0xB5F1u)
+#define INGEST_FRAME_VERSION  (2u)
+#define INGEST_FLAG_END       (0x01u)   /* end of stream marker */
+
+typedef enum {
+    INGEST_OK = 0,
+    INGEST_TICK_DONE,        /* frame completed a pack tick, estimators ran */
+    INGEST_END,              /* end-of-stream frame */
+    INGEST_ERR_FRAME,        /* bad size / magic / version */
+    INGEST_ERR_RANGE,        /* pack or cell id out of range */
+    INGEST_LATE,             /* frame for an already processed tick */
+    INGEST_DUPLICATE         /* cell already received this tick */
+} Ingest_Result_t;
+
+typedef struct {
+    uint64_t frames_ok;
+    uint64_t frames_bad;
+    uint64_t frames_late;
+    uint64_t frames_dup;
+    uint64_t ticks_done;
+    uint64_t ticks_incomplete;   /* flushed with some cells missing */
+    uint64_t end_frames_sent;    /* from END frame (0 if none seen) */
+    uint64_t lat_count;
+    uint64_t lat_overflow;       /* latencies beyond histogram range */
+    uint64_t lat_max_ns;
+} Ingest_Stats;
+
+/* Monotonic nanosecond clock, same time base as the sender stamps */
+typedef uint64_t (*Ingest_TimeFn)(void);
+
+/* Opaque engine, lives inside caller memory */
+typedef struct Ingest_Engine Ingest_Engine;
+
+/* Bytes needed (mem must be 8-byte aligned) */
+size_t Ingest_StateSize(uint32_t n_packs, uint32_t cells_per_pack);
+
+/*
+  Place engine in caller memory. NULL on bad args.
+  now_ns (optional) timestamps tick completion for end-to-end latency.
+*/
+Ingest_Engine* Ingest_Init(void *mem, size_t mem_bytes,
+                           uint32_t n_packs,
+                           uint32_t cells_per_pack,
+                           float init_soc,
+                           Ingest_TimeFn now_ns);
+
+/*
+  Decode one frame and file it into its pack batch. When the pack's
+  tick is complete the estimators run; a frame for a newer tick flushes
+  an incomplete one. Missing cells are not stepped for that tick; their
+  next frame covers the whole interval since their last one.
+*/
+Ingest_Result_t Ingest_Frame(Ingest_Engine *eng,
+                             const uint8_t *buf,
+                             size_t len);
+
+/*
+  Run the estimators for every pack holding a partially received tick,
+  as a newer tick would. Call at end of stream or shutdown so the last
+  samples are not dropped. Returns the number of packs flushed.
+*/
+uint32_t Ingest_FlushTick(Ingest_Engine *eng);
+
+/* Encode a frame (generator side). buf must hold INGEST_FRAME_SIZE bytes */
+void Ingest_EncodeFrame(uint8_t *buf,
+                        uint8_t flags,
+                        uint16_t pack_id,
+                        uint16_t cell_id,
+                        uint32_t tick,
+                        double time_s,
+                        float current_A,
+                        float voltage_V,
+                        float temp_C,
+                        uint64_t send_ns);
+
+/* Counters */
+const Ingest_Stats* Ingest_GetStats(const Ingest_Engine *eng);
+
+/* End-to-end latency percentile (0..100) in ns, from the histogram */
+uint64_t Ingest_LatencyPercentile(const Ingest_Engine *eng, float pct);
+
+/* Latest EKF SOC for a cell (0 on bad ids) */
+float Ingest_GetSOC(const Ingest_Engine *eng, uint32_t pack, uint32_t cell);
+
+/* Latest fault flags for a cell */
+uint8_t Ingest_GetFaults(const Ingest_Engine *eng, uint32_t pack, uint32_t cell);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
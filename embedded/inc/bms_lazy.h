@@ -0,0 +1,91 @@
+#ifndef BMS_LAZY_H_
+#define BMS_LAZY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "bms_model.h"
+#include "soc_estimator.h"
+#include "soh_estimator.h"
+#include "safety_fsm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  Event-driven (lazy) per-cell stepping for rest and steady operation.
+
+  A quiet window opens on a sample that is well inside every safety limit,
+  with no fault active or pending and current clear of the charge /
+  discharge deadband. While later samples stay within the configured
+  bands of that first sample, only the window sums are updated. The
+  window is flushed when a sample leaves the band, when it reaches
+  max_window_s, or on BMS_Lazy_Flush:
+
+    - ECM / EKF prediction: closed-form fast-forward at the mean current
+      (RC relaxation and covariance growth over the whole interval)
+    - EKF update: one measurement update with the last voltage
+    - SOH / Safety: one call with the mean current and total dt
+
+  The band-breaking sample is then stepped exactly. Safety gives the
+  same result as per-sample stepping because nothing it reacts to can
+  change inside a window. SOH sees equivalent charge throughput, but
+  its voltage extrema (v_min_cycle / v_max_cycle) are sampled at window
+  ends only, so they can miss a swing within v_band. The EKF differs
+  only by the skipped intermediate measurement updates.
+*/
+
+typedef struct {
+    float i_band;           /* max |I - I_first| in a window (A) */
+    float v_band;           /* max |V - V_first| (V) */
+    float t_band;           /* max |T - T_first| (degC) */
+    float max_window_s;     /* flush at least this often (s) */
+} BMS_Lazy_Config;
+
+typedef struct {
+    BMS_State  bms;
+    EKF_State  ekf;
+    SOH_State  soh;
+    Safety_FSM fsm;
+
+    /* Open window */
+    bool     in_window;
+    float    i_first, v_first, t_first;
+    float    win_s;         /* accumulated dt (s) */
+    float    win_as;        /* accumulated charge (A*s) */
+    uint32_t win_n;         /* deferred samples */
+    float    v_last, temp_last;
+
+    /* Statistics */
+    uint32_t steps_exact;
+    uint32_t steps_deferred;
+    uint32_t flushes;
+} BMS_Lazy_Cell;
+
+/* Defaults from bms_config.h */
+void BMS_Lazy_DefaultConfig(BMS_Lazy_Config *cfg);
+
+/* Initialize all estimators for one cell */
+void BMS_Lazy_Init(BMS_Lazy_Cell *cell, float init_soc);
+
+/*
+  One sample. Estimator state is current after every exact step and after
+  each flush; call BMS_Lazy_Flush before reading it mid-window.
+  Returns true if the sample was stepped exactly.
+*/
+bool BMS_Lazy_Step(BMS_Lazy_Cell *cell,
+                   const BMS_Lazy_Config *cfg,
+                   float current_A,
+                   float voltage_V,
+                   float temp_C,
+                   float dt_s);
+
+/* Apply any deferred interval now */
+void BMS_Lazy_Flush(BMS_Lazy_Cell *cell);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
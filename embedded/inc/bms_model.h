@@ -26,6 +26,9 @@ void BMS_Init(BMS_State *state);
 */
 void BMS_ECM_Step(BMS_State *state, float current, float dt);
 
+/* Closed-form equivalent of n_steps BMS_ECM_Step calls at constant current */
+void BMS_ECM_FastForward(BMS_State *state, float current, float dt_total, uint32_t n_steps);
+
 /* Get terminal voltage prediction using current state */
 float BMS_GetVoltage(const BMS_State *state, float current);
 
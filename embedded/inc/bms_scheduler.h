@@ -0,0 +1,104 @@
+#ifndef BMS_SCHEDULER_H_
+#define BMS_SCHEDULER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "bms_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  Fixed-priority, multi-rate cooperative scheduler.
+
+  Call Sched_RunTick() once per base tick. Due tasks run to completion
+  in priority order (0 = highest). Each run is timed against the task's
+  declared budget. Non-critical tasks are shed (deferred to a later tick)
+  when the remaining tick budget cannot cover their declared budget.
+*/
+
+/* Task body: ticks_elapsed = base ticks since this task last ran */
+typedef void (*Sched_TaskFn)(void *ctx, uint32_t ticks_elapsed);
+
+/* Monotonic microsecond clock (wraps at 2^32) */
+typedef uint32_t (*Sched_TimeFn)(void);
+
+typedef struct {
+    const char  *name;
+    Sched_TaskFn fn;
+    void        *ctx;
+
+    uint16_t period_ticks;   /* 0 = runs only when triggered */
+    uint16_t offset_ticks;   /* phase within period */
+    uint8_t  priority;       /* 0 = highest */
+    bool     critical;       /* never shed */
+    uint32_t budget_us;      /* declared WCET budget */
+
+    /* Runtime */
+    bool     pending;        /* released but not yet run */
+    uint32_t last_run_tick;
+
+    /* Statistics */
+    uint32_t run_count;
+    uint32_t overrun_count;  /* runs exceeding budget_us */
+    uint32_t shed_count;     /* activations deferred for lack of budget */
+    uint32_t last_us;
+    uint32_t wcet_us;        /* worst observed execution time */
+} Sched_Task;
+
+typedef struct {
+    Sched_Task tasks[SCHED_MAX_TASKS];
+    uint8_t    order[SCHED_MAX_TASKS];   /* task ids by priority */
+    uint8_t    n_tasks;
+
+    uint32_t   tick;
+    uint32_t   tick_budget_us;           /* 0 = no shedding */
+    Sched_TimeFn now_us;                 /* NULL = timing disabled */
+
+    /* Per-tick statistics */
+    uint32_t   tick_overruns;            /* ticks exceeding tick_budget_us */
+    uint32_t   last_tick_us;
+    uint32_t   tick_wcet_us;
+} Scheduler;
+
+/* Initialize empty scheduler */
+void Sched_Init(Scheduler *sched, Sched_TimeFn now_us, uint32_t tick_budget_us);
+
+/*
+  Register a task. Returns task id, or -1 if the table is full
+  or arguments are invalid.
+*/
+int Sched_AddTask(Scheduler *sched,
+                  const char *name,
+                  Sched_TaskFn fn,
+                  void *ctx,
+                  uint16_t period_ticks,
+                  uint16_t offset_ticks,
+                  uint8_t priority,
+                  uint32_t budget_us,
+                  bool critical);
+
+/*
+  Release a task (event-driven work, e.g. cycle end). Called between
+  ticks, it runs in the next tick. Called from a running task, it runs
+  later in the same tick if it ranks below the caller (safety triggering
+  SOH at cycle end), otherwise in the next tick.
+*/
+void Sched_Trigger(Scheduler *sched, int task_id);
+
+/* Run one base tick. Returns elapsed microseconds (0 if timing disabled) */
+uint32_t Sched_RunTick(Scheduler *sched);
+
+/* Read-only task access (NULL for bad id) */
+const Sched_Task* Sched_GetTask(const Scheduler *sched, int task_id);
+
+/* Clear statistics, keep task table and phase */
+void Sched_ResetStats(Scheduler *sched);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
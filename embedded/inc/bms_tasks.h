@@ -0,0 +1,91 @@
+#ifndef BMS_TASKS_H_
+#define BMS_TASKS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "bms_model.h"
+#include "soc_estimator.h"
+#include "soh_estimator.h"
+#include "safety_fsm.h"
+#include "bms_scheduler.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Standard BMS tasks, in priority order */
+typedef enum {
+    BMS_TASK_SAFETY = 0,   /* Safety_Check, critical, never shed */
+    BMS_TASK_EKF,          /* EKF_Predict + EKF_Update */
+    BMS_TASK_ECM,          /* BMS_ECM_Step */
+    BMS_TASK_SOH,          /* SOH_Update */
+    BMS_TASK_COUNT
+} BMS_Task_t;
+
+/*
+  Per-cell accounting kept by the safety task, which sees every tick.
+  Slower or shed tasks take the charge integrated since they last ran
+  instead of holding the latest current over the skipped ticks.
+*/
+typedef struct {
+    float ecm_As;          /* charge since BMS_ECM_Step last ran (A*s) */
+    float ekf_As;          /* charge since EKF_Predict last ran (A*s) */
+    float soh_As;          /* discharge since the last cycle end (A*s) */
+    float v_prev;          /* voltage of the previous tick */
+
+    /* End of discharge latched for the SOH task */
+    bool  cycle_end;
+    float cycle_As;
+    float cycle_I;
+    float cycle_v;
+    float cycle_v_prev;
+} BMS_Cell_Acc;
+
+/* Pack context: caller-owned per-cell state arrays (no allocation) */
+typedef struct {
+    uint32_t      n_cells;
+    BMS_State    *bms;
+    EKF_State    *ekf;
+    SOH_State    *soh;
+    Safety_FSM   *fsm;
+    BMS_Cell_Acc *acc;
+
+    /* Latest samples per cell, refreshed by acquisition before each tick */
+    const float *current_A;
+    const float *voltage_V;
+    const float *temp_C;
+
+    float tick_dt_s;       /* base tick period (s) */
+
+    /* Set by BMS_Tasks_Register */
+    Scheduler *sched;
+    int        soh_task;
+} BMS_Pack;
+
+typedef struct {
+    uint16_t period_ticks[BMS_TASK_COUNT];   /* 0 = trigger only */
+    uint32_t budget_us[BMS_TASK_COUNT];      /* 0 = unmonitored */
+} BMS_Task_Config;
+
+/* Rates from bms_config.h, budgets unset */
+void BMS_Tasks_DefaultConfig(BMS_Task_Config *cfg);
+
+/*
+  Register the standard tasks for a pack.
+  ECM and EKF advance over dt = ticks_elapsed * tick_dt_s with the mean
+  current of the skipped ticks, so no charge is lost when they run
+  slower than the tick or are shed. SOH is triggered by the safety task
+  at the end of a discharge (period 0 in the default config).
+  task_ids (optional) receives the scheduler id of each task.
+*/
+bool BMS_Tasks_Register(Scheduler *sched,
+                        BMS_Pack *pack,
+                        const BMS_Task_Config *cfg,
+                        int task_ids[BMS_TASK_COUNT]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
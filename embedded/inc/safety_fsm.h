@@ -32,6 +32,9 @@ typedef enum {
     FAULT_COMMS         = 0x80
 } Fault_Flag_t;
 
+/* Debounced fault channels (order matches Fault_Flag_t bits 0..5) */
+#define SAFETY_NUM_CHANNELS (6u)
+
 /* Safety FSM */
 typedef struct {
     BMS_State_t current_state;
@@ -43,24 +46,42 @@ typedef struct {
     /* Limits for current state (optional runtime limits) */
     float current_limit;   /* max allowed |current| */
 
-    /* Timing */
+    /*
+      Timing (ms, advanced by Safety_Check dt). current_time wraps every
+      2^32 ms (~49.7 days): take intervals by unsigned subtraction, as
+      Safety_TimeInState does, never by comparing timestamps.
+    */
     uint32_t state_entry_time;
     uint32_t current_time;
+
+    /* Per-channel debounce: time the set/clear condition has persisted */
+    uint32_t debounce_ms[SAFETY_NUM_CHANNELS];
+    uint8_t  debounce_armed;   /* bit per channel: timer running */
+    uint8_t  raw_flags;        /* undebounced limit violations, last check */
 } Safety_FSM;
 
 /* Initialize safety FSM */
 void Safety_Init(Safety_FSM *fsm);
 
-/* Run safety checks (call every step) */
+/*
+  Run safety checks (call every step).
+  dt_s advances current_time. A fault sets once its limit has been
+  violated continuously for the channel's set time, and clears once the
+  value has been back inside the limit minus hysteresis for its clear time.
+*/
 void Safety_Check(Safety_FSM *fsm,
                   float voltage,
                   float current,
                   float temperature,
-                  float soc);
+                  float soc,
+                  float dt_s);
 
 /* Get current state */
 BMS_State_t Safety_GetState(const Safety_FSM *fsm);
 
+/* Time since the last state change (ms), correct across current_time wrap */
+uint32_t Safety_TimeInState(const Safety_FSM *fsm);
+
 /* Human-readable fault string (NOT thread-safe; uses static buffer) */
 const char* Safety_GetFaultString(uint8_t fault_flags);
 
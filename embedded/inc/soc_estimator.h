@@ -34,6 +34,13 @@ void EKF_Init(EKF_State *ekf, float init_soc);
 /* Prediction step */
 void EKF_Predict(EKF_State *ekf, float current, float dt);
 
+/*
+  Closed-form equivalent of n_steps EKF_Predict calls at constant current
+  spanning dt_total: RC relaxation via exp(-dt_total/tau) and covariance
+  growth via the geometric sum of the per-step process noise.
+*/
+void EKF_FastForward(EKF_State *ekf, float current, float dt_total, uint32_t n_steps);
+
 /* Update step using measured terminal voltage */
 void EKF_Update(EKF_State *ekf, float v_measured, float current);
 
@@ -46,6 +46,20 @@ void SOH_Update(SOH_State *soh,
                 float voltage_V,
                 float dt_s);
 
+/*
+  SOH_Update for a window of samples the caller has already coulomb
+  counted (e.g. a scheduler that runs SOH only at cycle end).
+    discharged_As  : charge of the window's samples below -0.05 A
+    current_A / voltage_V : last sample of the window
+    prev_voltage_V : the sample before it, for end-of-discharge detection
+  Min/max voltage tracking only sees the last sample.
+*/
+void SOH_UpdateWindow(SOH_State *soh,
+                      float discharged_As,
+                      float current_A,
+                      float voltage_V,
+                      float prev_voltage_V);
+
 /*
   Check if cycle just completed
   Returns true exactly once when a discharge cycle completes.
@@ -0,0 +1,144 @@
+#include "bms_batch.h"
+#include "bms_config.h"
+#include "bms_model.h"
+#include "soc_estimator.h"
+#include "soh_estimator.h"
+#include "safety_fsm.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#define BMS_BATCH_MAGIC  (0x42415443u)   /* "BATC" */
+#define BMS_BATCH_ALIGN  (8u)
+
+/* Full per-cell estimator state, kept together so one cell stays in cache */
+typedef struct {
+    BMS_State  bms;
+    EKF_State  ekf;
+    SOH_State  soh;
+    Safety_FSM fsm;
+    double     t_prev;        /* last timestamp seen (s) */
+    bool       t_valid;       /* t_prev seeded by a first sample */
+} BMS_Batch_Cell;
+
+struct BMS_Batch {
+    uint32_t magic;
+    uint32_t n_cells;
+    BMS_Batch_Cell cells[];
+};
+
+static bool batch_valid(const BMS_Batch *batch)
+{
+    return (batch != NULL) && (batch->magic == BMS_BATCH_MAGIC);
+}
+
+static void cell_init(BMS_Batch_Cell *cell, float init_soc)
+{
+    BMS_Init(&cell->bms);
+    cell->bms.soc = init_soc;
+    EKF_Init(&cell->ekf, init_soc);
+    SOH_Init(&cell->soh, NOMINAL_CAPACITY);
+    Safety_Init(&cell->fsm);
+    cell->t_prev = 0.0;
+    cell->t_valid = false;
+}
+
+size_t BMS_Batch_StateSize(uint32_t n_cells)
+{
+    return sizeof(BMS_Batch) + (size_t)n_cells * sizeof(BMS_Batch_Cell);
+}
+
+BMS_Batch* BMS_Batch_Init(void *mem, size_t mem_bytes,
+                          uint32_t n_cells, float init_soc)
+{
+    if (mem == NULL) return NULL;
+    if (((uintptr_t)mem % BMS_BATCH_ALIGN) != 0u) return NULL;
+    if (mem_bytes < BMS_Batch_StateSize(n_cells)) return NULL;
+
+    BMS_Batch *batch = (BMS_Batch *)mem;
+    batch->magic = BMS_BATCH_MAGIC;
+    batch->n_cells = n_cells;
+
+    for (uint32_t c = 0; c < n_cells; c++) {
+        cell_init(&batch->cells[c], init_soc);
+    }
+
+    return batch;
+}
+
+void BMS_Batch_ResetCell(BMS_Batch *batch, uint32_t cell, float init_soc)
+{
+    if (!batch_valid(batch) || cell >= batch->n_cells) return;
+    cell_init(&batch->cells[cell], init_soc);
+}
+
+uint32_t BMS_Batch_NumCells(const BMS_Batch *batch)
+{
+    return batch_valid(batch) ? batch->n_cells : 0u;
+}
+
+size_t BMS_Batch_Run(BMS_Batch *batch,
+                     const BMS_Batch_Input *in,
+                     BMS_Batch_Output *out,
+                     size_t n_samples,
+                     size_t ld)
+{
+    if (!batch_valid(batch) || in == NULL) return 0;
+    if (in->time_s == NULL || in->current_A == NULL ||
+        in->voltage_V == NULL || in->temp_C == NULL) return 0;
+    if (ld < n_samples) return 0;
+
+    /* Outputs are optional; resolve once instead of per sample */
+    float   *o_soc   = (out != NULL) ? out->soc         : NULL;
+    float   *o_v1    = (out != NULL) ? out->v1          : NULL;
+    float   *o_vpred = (out != NULL) ? out->v_pred      : NULL;
+    float   *o_innov = (out != NULL) ? out->innovation  : NULL;
+    uint8_t *o_fault = (out != NULL) ? out->fault_flags : NULL;
+
+    /* Cell-outer, sample-inner: cell state stays hot, columns stream */
+    for (uint32_t c = 0; c < batch->n_cells; c++) {
+        BMS_Batch_Cell *cell = &batch->cells[c];
+        const size_t base = (size_t)c * ld;
+
+        const double *t = in->time_s   + base;
+        const float *I = in->current_A + base;
+        const float *V = in->voltage_V + base;
+        const float *T = in->temp_C    + base;
+        const uint8_t *ok = (in->valid != NULL) ? in->valid + base : NULL;
+
+        for (size_t k = 0; k < n_samples; k++) {
+            /* Missing sample: state and clock untouched, outputs hold */
+            if (ok == NULL || ok[k] != 0u) {
+                /* Difference in double, then narrow: dt stays exact for epoch times */
+                const float dt = cell->t_valid ? (float)(t[k] - cell->t_prev) : 0.0f;
+                cell->t_prev = t[k];
+                cell->t_valid = true;
+
+                BMS_ECM_Step(&cell->bms, I[k], dt);
+                EKF_Predict(&cell->ekf, I[k], dt);
+                EKF_Update(&cell->ekf, V[k], I[k]);
+                SOH_Update(&cell->soh, I[k], V[k], dt);
+                Safety_Check(&cell->fsm, V[k], I[k], T[k], cell->ekf.soc, dt);
+            }
+
+            if (o_soc   != NULL) o_soc[base + k]   = cell->ekf.soc;
+            if (o_v1    != NULL) o_v1[base + k]    = cell->ekf.v1;
+            if (o_vpred != NULL) o_vpred[base + k] = cell->ekf.last_v_pred;
+            if (o_innov != NULL) o_innov[base + k] = cell->ekf.last_innov;
+            if (o_fault != NULL) o_fault[base + k] = cell->fsm.fault_flags;
+        }
+    }
+
+    return n_samples;
+}
+
+float BMS_Batch_GetSOH(const BMS_Batch *batch, uint32_t cell)
+{
+    if (!batch_valid(batch) || cell >= batch->n_cells) return 0.0f;
+    return SOH_GetPercentage(&batch->cells[cell].soh);
+}
+
+int BMS_Batch_GetSafetyState(const BMS_Batch *batch, uint32_t cell)
+{
+    if (!batch_valid(batch) || cell >= batch->n_cells) return (int)BMS_STATE_FAULT;
+    return (int)Safety_GetState(&batch->cells[cell].fsm);
+}
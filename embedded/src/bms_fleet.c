@@ -0,0 +1,389 @@
+#include "bms_fleet.h"
+#include "bms_config.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define FLEET_MAGIC    (0x464C5431u)   /* "FLT1" */
+#define FLEET_VERSION  (2u)
+#define FLEET_ALIGN    (8u)
+
+/* Written every step */
+typedef struct {
+    float    ekf_soc;                /* fp32: per-step SOC increments are ~1e-4 */
+    float    bms_soc;
+    float    discharged_Ah;
+    uint32_t time_ms;                /* Safety_FSM.current_time */
+    uint32_t step_count;
+    uint16_t ekf_v1;                 /* fp16 */
+    uint16_t bms_v1;                 /* fp16 */
+    uint16_t i_prev;                 /* fp16 A, BMS_ECM_Step input */
+    uint16_t vterm_mV;               /* BMS_ECM_Step output */
+    uint16_t p11, p12, p22;          /* fp16, P symmetric: p21 == p12 */
+    uint16_t prev_mV;                /* SOH voltages, 1 mV */
+    uint16_t vmin_mV;
+    uint16_t vmax_mV;
+    uint16_t debounce_ms[SAFETY_NUM_CHANNELS];   /* saturating */
+    uint8_t  fault_flags;
+    uint8_t  debounce_armed;
+    uint8_t  state_bits;             /* bits 0..2 BMS_State_t, bit 3 is_charging */
+    uint8_t  reserved;
+} Fleet_Hot;
+
+/* Changes on cycle / state events only */
+typedef struct {
+    uint32_t total_cycles;
+    uint32_t fault_start_time;
+    uint32_t state_entry_time;
+    uint16_t cap_init;               /* fp16 Ah */
+    uint16_t cap_est;                /* fp16 Ah */
+    uint16_t protection_count;       /* saturating */
+    uint8_t  cycles_since_update;
+    uint8_t  reserved;
+} Fleet_Cold;
+
+struct Fleet_Store {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t n_cells;
+    uint32_t hot_size;
+    uint32_t cold_size;
+    uint32_t hot_offset;             /* bytes from start of store */
+    uint32_t cold_offset;
+
+    /* Fleet-wide constants, identical for every cell */
+    float    q11;
+    float    q22;
+    float    r_voltage;
+    float    current_limit;
+    uint32_t reserved;
+};
+
+/* ---------- Packing helpers ---------- */
+
+typedef union {
+    float    f;
+    uint32_t u;
+} f32_bits;
+
+/* IEEE binary32 -> binary16, round to nearest even */
+static uint16_t f32_to_f16(float x)
+{
+    f32_bits v;
+    v.f = x;
+
+    const uint16_t sign = (uint16_t)((v.u >> 16) & 0x8000u);
+    const uint32_t a = v.u & 0x7FFFFFFFu;
+
+    if (a >= 0x7F800000u) return (uint16_t)(sign | 0x7C00u | ((a > 0x7F800000u) ? 0x200u : 0u));
+    if (a >= 0x477FF000u) return (uint16_t)(sign | 0x7C00u);   /* overflow -> inf */
+
+    if (a < 0x38800000u) {
+        /* Half subnormal (or zero) */
+        if (a < 0x33000000u) return sign;
+        const uint32_t e = a >> 23;
+        const uint32_t m = (a & 0x7FFFFFu) | 0x800000u;
+        const uint32_t shift = 126u - e;
+        uint32_t r = m >> shift;
+        const uint32_t rem = m & ((1u << shift) - 1u);
+        const uint32_t half = 1u << (shift - 1u);
+        if (rem > half || (rem == half && (r & 1u))) r++;
+        return (uint16_t)(sign | r);
+    }
+
+    uint32_t r = (a - 0x38000000u) >> 13;
+    const uint32_t rem = a & 0x1FFFu;
+    if (rem > 0x1000u || (rem == 0x1000u && (r & 1u))) r++;
+    return (uint16_t)(sign | r);
+}
+
+static float f16_to_f32(uint16_t h)
+{
+    const uint32_t sign = ((uint32_t)h & 0x8000u) << 16;
+    const uint32_t e = ((uint32_t)h >> 10) & 0x1Fu;
+    const uint32_t m = (uint32_t)h & 0x3FFu;
+    f32_bits v;
+
+    if (e == 0u) {
+        const float f = (float)m * (1.0f / 16777216.0f);   /* m * 2^-24 */
+        return (sign != 0u) ? -f : f;
+    }
+
+    if (e == 31u) v.u = sign | 0x7F800000u | (m << 13);
+    else          v.u = sign | ((e + 112u) << 23) | (m << 13);
+    return v.f;
+}
+
+static uint16_t to_mV(float volts)
+{
+    const float mv = volts * 1000.0f + 0.5f;
+    if (mv <= 0.0f) return 0u;
+    if (mv >= 65535.0f) return 65535u;
+    return (uint16_t)mv;
+}
+
+static float from_mV(uint16_t mv)
+{
+    return (float)mv * 0.001f;
+}
+
+static uint16_t sat_u16(uint32_t x)
+{
+    return (x > 0xFFFFu) ? 0xFFFFu : (uint16_t)x;
+}
+
+/* ---------- Store layout ---------- */
+
+static size_t align_up(size_t x)
+{
+    return (x + (FLEET_ALIGN - 1u)) & ~(size_t)(FLEET_ALIGN - 1u);
+}
+
+static size_t hot_offset(void)
+{
+    return align_up(sizeof(Fleet_Store));
+}
+
+static size_t cold_offset(uint32_t n_cells)
+{
+    return align_up(hot_offset() + (size_t)n_cells * sizeof(Fleet_Hot));
+}
+
+static Fleet_Hot* hot_rec(const Fleet_Store *store, uint32_t cell)
+{
+    return (Fleet_Hot *)((uint8_t *)store + store->hot_offset) + cell;
+}
+
+static Fleet_Cold* cold_rec(const Fleet_Store *store, uint32_t cell)
+{
+    return (Fleet_Cold *)((uint8_t *)store + store->cold_offset) + cell;
+}
+
+size_t Fleet_StoreSize(uint32_t n_cells)
+{
+    return cold_offset(n_cells) + (size_t)n_cells * sizeof(Fleet_Cold);
+}
+
+size_t Fleet_BytesPerCell(void)
+{
+    return sizeof(Fleet_Hot) + sizeof(Fleet_Cold);
+}
+
+/* ---------- Expand / pack ---------- */
+
+bool Fleet_Expand(const Fleet_Store *store, uint32_t cell, Fleet_Cell *work)
+{
+    if (store == NULL || work == NULL || cell >= store->n_cells) return false;
+
+    const Fleet_Hot  *h = hot_rec(store, cell);
+    const Fleet_Cold *c = cold_rec(store, cell);
+
+    /* ECM twin */
+    work->bms.soc        = h->bms_soc;
+    work->bms.v1         = f16_to_f32(h->bms_v1);
+    work->bms.v_terminal = from_mV(h->vterm_mV);
+    work->bms.i_prev     = f16_to_f32(h->i_prev);
+    work->bms.step_count = h->step_count;
+
+    /* EKF */
+    work->ekf.soc = h->ekf_soc;
+    work->ekf.v1  = f16_to_f32(h->ekf_v1);
+    work->ekf.p11 = f16_to_f32(h->p11);
+    work->ekf.p12 = f16_to_f32(h->p12);
+    work->ekf.p21 = work->ekf.p12;
+    work->ekf.p22 = f16_to_f32(h->p22);
+    work->ekf.q11 = store->q11;
+    work->ekf.q22 = store->q22;
+    work->ekf.r_voltage = store->r_voltage;
+    work->ekf.last_v_pred = 0.0f;
+    work->ekf.last_innov  = 0.0f;
+
+    /* SOH */
+    work->soh.capacity_initial_Ah = f16_to_f32(c->cap_init);
+    work->soh.capacity_est_Ah     = f16_to_f32(c->cap_est);
+    work->soh.soh_percent = (work->soh.capacity_initial_Ah > 0.0f)
+                          ? (work->soh.capacity_est_Ah / work->soh.capacity_initial_Ah) * 100.0f
+                          : 0.0f;
+    work->soh.total_cycles        = c->total_cycles;
+    work->soh.cycles_since_update = c->cycles_since_update;
+    work->soh.is_charging         = (h->state_bits & 0x08u) != 0u;
+    work->soh.discharged_Ah       = h->discharged_Ah;
+    work->soh.v_min_cycle         = from_mV(h->vmin_mV);
+    work->soh.v_max_cycle         = from_mV(h->vmax_mV);
+    work->soh.prev_voltage        = from_mV(h->prev_mV);
+
+    /* Safety */
+    work->fsm.current_state    = (BMS_State_t)(h->state_bits & 0x07u);
+    work->fsm.fault_flags      = h->fault_flags;
+    work->fsm.fault_start_time = c->fault_start_time;
+    work->fsm.protection_count = c->protection_count;
+    work->fsm.current_limit    = store->current_limit;
+    work->fsm.state_entry_time = c->state_entry_time;
+    work->fsm.current_time     = h->time_ms;
+    for (uint8_t ch = 0; ch < SAFETY_NUM_CHANNELS; ch++) {
+        work->fsm.debounce_ms[ch] = h->debounce_ms[ch];
+    }
+    work->fsm.debounce_armed = h->debounce_armed;
+    work->fsm.raw_flags = FAULT_NONE;
+
+    return true;
+}
+
+static void pack_hot(Fleet_Hot *h, const Fleet_Cell *work)
+{
+    h->ekf_soc       = work->ekf.soc;
+    h->bms_soc       = work->bms.soc;
+    h->discharged_Ah = work->soh.discharged_Ah;
+    h->time_ms       = work->fsm.current_time;
+    h->step_count    = work->bms.step_count;
+    h->ekf_v1        = f32_to_f16(work->ekf.v1);
+    h->bms_v1        = f32_to_f16(work->bms.v1);
+    h->i_prev        = f32_to_f16(work->bms.i_prev);
+    h->vterm_mV      = to_mV(work->bms.v_terminal);
+    h->p11           = f32_to_f16(work->ekf.p11);
+    h->p12           = f32_to_f16(0.5f * (work->ekf.p12 + work->ekf.p21));
+    h->p22           = f32_to_f16(work->ekf.p22);
+    h->prev_mV       = to_mV(work->soh.prev_voltage);
+    h->vmin_mV       = to_mV(work->soh.v_min_cycle);
+    h->vmax_mV       = to_mV(work->soh.v_max_cycle);
+    for (uint8_t ch = 0; ch < SAFETY_NUM_CHANNELS; ch++) {
+        h->debounce_ms[ch] = sat_u16(work->fsm.debounce_ms[ch]);
+    }
+    h->fault_flags    = work->fsm.fault_flags;
+    h->debounce_armed = work->fsm.debounce_armed;
+    h->state_bits     = (uint8_t)(((uint8_t)work->fsm.current_state & 0x07u) |
+                                  (work->soh.is_charging ? 0x08u : 0x00u));
+    h->reserved       = 0u;
+}
+
+/*
+  Quantize and write the cold record only if it differs from what is
+  stored, so cold pages of a mapped store stay clean between events.
+*/
+static void pack_cold(Fleet_Cold *c, const Fleet_Cell *work)
+{
+    Fleet_Cold next;
+    next.total_cycles        = work->soh.total_cycles;
+    next.fault_start_time    = work->fsm.fault_start_time;
+    next.state_entry_time    = work->fsm.state_entry_time;
+    next.cap_init            = f32_to_f16(work->soh.capacity_initial_Ah);
+    next.cap_est             = f32_to_f16(work->soh.capacity_est_Ah);
+    next.protection_count    = sat_u16(work->fsm.protection_count);
+    next.cycles_since_update = (uint8_t)((work->soh.cycles_since_update > 0xFFu) ? 0xFFu : work->soh.cycles_since_update);
+    next.reserved            = 0u;
+
+    if (memcmp(c, &next, sizeof(next)) != 0) *c = next;
+}
+
+bool Fleet_Pack(Fleet_Store *store, uint32_t cell, const Fleet_Cell *work)
+{
+    if (store == NULL || work == NULL || cell >= store->n_cells) return false;
+
+    pack_hot(hot_rec(store, cell), work);
+    pack_cold(cold_rec(store, cell), work);
+
+    return true;
+}
+
+const void* Fleet_ColdRegion(const Fleet_Store *store, size_t *bytes)
+{
+    if (store == NULL) return NULL;
+    if (bytes != NULL) *bytes = (size_t)store->n_cells * sizeof(Fleet_Cold);
+    return cold_rec(store, 0u);
+}
+
+/* ---------- Store lifecycle ---------- */
+
+Fleet_Store* Fleet_Create(void *mem, size_t mem_bytes,
+                          uint32_t n_cells, float init_soc)
+{
+    if (mem == NULL) return NULL;
+    if (((uintptr_t)mem % FLEET_ALIGN) != 0u) return NULL;
+    if (mem_bytes < Fleet_StoreSize(n_cells)) return NULL;
+
+    Fleet_Store *store = (Fleet_Store *)mem;
+    store->magic       = FLEET_MAGIC;
+    store->version     = FLEET_VERSION;
+    store->n_cells     = n_cells;
+    store->hot_size    = (uint32_t)sizeof(Fleet_Hot);
+    store->cold_size   = (uint32_t)sizeof(Fleet_Cold);
+    store->hot_offset  = (uint32_t)hot_offset();
+    store->cold_offset = (uint32_t)cold_offset(n_cells);
+    store->reserved    = 0u;
+
+    /* One fresh cell gives both the fleet constants and the template */
+    Fleet_Cell work;
+    BMS_Init(&work.bms);
+    work.bms.soc = init_soc;
+    EKF_Init(&work.ekf, init_soc);
+    SOH_Init(&work.soh, NOMINAL_CAPACITY);
+    Safety_Init(&work.fsm);
+
+    store->q11 = work.ekf.q11;
+    store->q22 = work.ekf.q22;
+    store->r_voltage = work.ekf.r_voltage;
+    store->current_limit = work.fsm.current_limit;
+
+    for (uint32_t c = 0; c < n_cells; c++) {
+        Fleet_Pack(store, c, &work);
+    }
+
+    return store;
+}
+
+Fleet_Store* Fleet_Attach(void *mem, size_t mem_bytes)
+{
+    if (mem == NULL || mem_bytes < sizeof(Fleet_Store)) return NULL;
+    if (((uintptr_t)mem % FLEET_ALIGN) != 0u) return NULL;
+
+    Fleet_Store *store = (Fleet_Store *)mem;
+    if (store->magic != FLEET_MAGIC || store->version != FLEET_VERSION) return NULL;
+    if (store->hot_size != sizeof(Fleet_Hot) || store->cold_size != sizeof(Fleet_Cold)) return NULL;
+    if (store->hot_offset != hot_offset() || store->cold_offset != cold_offset(store->n_cells)) return NULL;
+    if (mem_bytes < Fleet_StoreSize(store->n_cells)) return NULL;
+
+    return store;
+}
+
+uint32_t Fleet_NumCells(const Fleet_Store *store)
+{
+    return (store != NULL) ? store->n_cells : 0u;
+}
+
+uint32_t Fleet_Step(Fleet_Store *store,
+                    uint32_t first,
+                    uint32_t count,
+                    const float *current_A,
+                    const float *voltage_V,
+                    const float *temp_C,
+                    float dt_s,
+                    float *soc_out)
+{
+    if (store == NULL || current_A == NULL || voltage_V == NULL || temp_C == NULL) return 0u;
+    if (first >= store->n_cells) return 0u;
+    if (count > store->n_cells - first) count = store->n_cells - first;
+
+    Fleet_Cell work;
+
+    for (uint32_t k = 0; k < count; k++) {
+        const uint32_t cell = first + k;
+        const float I = current_A[k];
+        const float V = voltage_V[k];
+
+        Fleet_Expand(store, cell, &work);
+
+        BMS_ECM_Step(&work.bms, I, dt_s);
+        EKF_Predict(&work.ekf, I, dt_s);
+        EKF_Update(&work.ekf, V, I);
+        SOH_Update(&work.soh, I, V, dt_s);
+        Safety_Check(&work.fsm, V, I, temp_C[k], work.ekf.soc, dt_s);
+
+        /* pack_cold writes the cold record only on cycle / state events */
+        pack_hot(hot_rec(store, cell), &work);
+        pack_cold(cold_rec(store, cell), &work);
+
+        if (soc_out != NULL) soc_out[k] = work.ekf.soc;
+    }
+
+    return count;
+}
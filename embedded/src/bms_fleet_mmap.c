@@ -0,0 +1,87 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include "bms_fleet.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static void map_reset(Fleet_Mapping *map)
+{
+    map->base = NULL;
+    map->bytes = 0u;
+    map->fd = -1;
+}
+
+Fleet_Store* Fleet_MapFile(const char *path,
+                           uint32_t n_cells,
+                           float init_soc,
+                           Fleet_Mapping *map)
+{
+    if (path == NULL || map == NULL) return NULL;
+    map_reset(map);
+
+    bool created = false;
+    int fd = open(path, O_RDWR);
+    if (fd < 0 && errno == ENOENT) {
+        if (n_cells == 0u) return NULL;
+        fd = open(path, O_RDWR | O_CREAT | O_EXCL, 0644);
+        created = true;
+    }
+    if (fd < 0) return NULL;
+
+    size_t bytes;
+    if (created) {
+        bytes = Fleet_StoreSize(n_cells);
+        if (ftruncate(fd, (off_t)bytes) != 0) {
+            close(fd);
+            unlink(path);
+            return NULL;
+        }
+    } else {
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            close(fd);
+            return NULL;
+        }
+        bytes = (size_t)st.st_size;
+    }
+
+    void *base = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        if (created) unlink(path);
+        return NULL;
+    }
+
+    Fleet_Store *store = created ? Fleet_Create(base, bytes, n_cells, init_soc)
+                                 : Fleet_Attach(base, bytes);
+
+    if (store == NULL || (n_cells != 0u && Fleet_NumCells(store) != n_cells)) {
+        munmap(base, bytes);
+        close(fd);
+        if (created) unlink(path);
+        return NULL;
+    }
+
+    map->base = base;
+    map->bytes = bytes;
+    map->fd = fd;
+    return store;
+}
+
+bool Fleet_Sync(Fleet_Mapping *map)
+{
+    if (map == NULL || map->base == NULL) return false;
+    return msync(map->base, map->bytes, MS_SYNC) == 0;
+}
+
+void Fleet_Unmap(Fleet_Mapping *map)
+{
+    if (map == NULL) return;
+    if (map->base != NULL) munmap(map->base, map->bytes);
+    if (map->fd >= 0) close(map->fd);
+    map_reset(map);
+}
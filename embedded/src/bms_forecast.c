@@ -0,0 +1,237 @@
+#include "bms_forecast.h"
+#include "bms_config.h"
+#include <math.h>
+#include <string.h>
+
+/* OCV model as in soc_estimator.c: OCV = 3.2 + 1.0 * soc */
+#define FORECAST_OCV_0      (3.2f)
+#define FORECAST_OCV_SLOPE  (1.0f)
+
+/*
+  One block of scenarios in struct-of-arrays form. The hot loop only
+  records the step in which a lane first becomes empty, together with
+  the values bracketing it; the crossing time inside that step is
+  interpolated once afterwards, keeping divisions out of the loop.
+
+  Lane bookkeeping uses 0/1 float weights rather than conditional
+  assignments: with the default -ftrapping-math gcc will not if-convert
+  a loop whose floating-point arithmetic ends up behind a branch.
+*/
+typedef struct {
+    float soc[FORECAST_LANES];
+    float v1[FORECAST_LANES];
+    float v_min[FORECAST_LANES];
+
+    float live[FORECAST_LANES];         /* 1 until the lane is empty, then 0 */
+    float n_live[FORECAST_LANES];       /* steps completed before the empty one */
+    float hit_v0[FORECAST_LANES];       /* terminal voltage at start / end of it */
+    float hit_v1[FORECAST_LANES];
+    float hit_s0[FORECAST_LANES];       /* SOC at start / end of it */
+    float hit_s1[FORECAST_LANES];
+} Lane_Block;
+
+/* Per-run constants of the discretized model */
+typedef struct {
+    float dt;
+    float alpha;        /* exp(-dt / tau) */
+    float r1_gain;      /* R1 * (1 - alpha) */
+    float soc_per_as;   /* 1 / (capacity * 3600) */
+} Step_Coef;
+
+static float ocv_from_soc(float soc)
+{
+    return FORECAST_OCV_0 + FORECAST_OCV_SLOPE * soc;
+}
+
+/*
+  Advance every lane of a block by one step. Fixed trip count and
+  branch-free body so the compiler can map lanes to SIMD registers.
+*/
+static void block_step(Lane_Block *restrict b,
+                       const float *restrict cur,
+                       const Step_Coef *c)
+{
+    for (uint32_t j = 0; j < FORECAST_LANES; j++) {
+        const float I = cur[j];
+        const float ia = fabsf(I);
+
+        const float soc0 = b->soc[j];
+        const float v1_0 = b->v1[j];
+
+        /* Step start: R0 drop applies immediately */
+        const float v_start = ocv_from_soc(soc0) - v1_0 - ia * R0;
+
+        /*
+          Closed-form RC over the step, coulomb-counted SOC. SOC saturates
+          at SOC_MAX like the EKF; it is not clamped at SOC_MIN because
+          nothing after a lane's first empty step is reported except
+          soc_end, which is clamped on output.
+        */
+        const float soc_raw = soc0 + I * c->soc_per_as * c->dt;
+        const float sat = (float)(soc_raw > SOC_MAX);
+        const float soc = soc_raw + sat * (SOC_MAX - soc_raw);
+        const float v1 = v1_0 * c->alpha + ia * c->r1_gain;
+        const float v_end = ocv_from_soc(soc) - v1 - ia * R0;
+
+        /* first = 1 only in the step that ends empty for the first time */
+        const float live = b->live[j];
+        const float empty = (float)((v_end < VOLTAGE_MIN) | (soc <= SOC_MIN));
+        const float first = live * empty;
+
+        b->hit_v0[j] += first * (v_start - b->hit_v0[j]);
+        b->hit_v1[j] += first * (v_end   - b->hit_v1[j]);
+        b->hit_s0[j] += first * (soc0    - b->hit_s0[j]);
+        b->hit_s1[j] += first * (soc     - b->hit_s1[j]);
+
+        /* Lowest voltage while live */
+        const float vm = (v_start < v_end) ? v_start : v_end;
+        const float vm_live = (live > 0.0f) ? vm : INFINITY;
+        b->v_min[j] = (vm_live < b->v_min[j]) ? vm_live : b->v_min[j];
+
+        b->live[j] = live - first;
+        b->n_live[j] += live - first;
+        b->soc[j] = soc;
+        b->v1[j] = v1;
+    }
+}
+
+/* Time to empty from the recorded first empty step */
+static float crossing_time(const Lane_Block *b, uint32_t j, float dt)
+{
+    if (b->live[j] > 0.0f) return INFINITY;
+
+    float f = 1.0f;
+    const float v0 = b->hit_v0[j], v1 = b->hit_v1[j];
+    if (v1 < VOLTAGE_MIN) {
+        const float fv = (v0 <= VOLTAGE_MIN) ? 0.0f : (v0 - VOLTAGE_MIN) / (v0 - v1);
+        if (fv < f) f = fv;
+    }
+    const float s0 = b->hit_s0[j], s1 = b->hit_s1[j];
+    if (s1 <= SOC_MIN) {
+        const float fs = (s0 <= SOC_MIN) ? 0.0f : (s0 - SOC_MIN) / (s0 - s1);
+        if (fs < f) f = fs;
+    }
+    return (b->n_live[j] + f) * dt;
+}
+
+size_t BMS_Forecast_Run(const EKF_State *ekf,
+                        const BMS_Forecast_Scenarios *sc,
+                        BMS_Forecast_Output *out)
+{
+    if (ekf == NULL || sc == NULL || sc->current_A == NULL) return 0;
+    if (sc->ld < sc->n_scenarios || !(sc->dt_s > 0.0f)) return 0;
+
+    const float tau = R1 * C1;
+    Step_Coef coef;
+    coef.dt = sc->dt_s;
+    coef.alpha = (tau > 1e-9f) ? expf(-sc->dt_s / tau) : 0.0f;
+    coef.r1_gain = R1 * (1.0f - coef.alpha);
+    coef.soc_per_as = 1.0f / (NOMINAL_CAPACITY * 3600.0f);
+
+    Lane_Block b;
+    float pad[FORECAST_LANES];
+
+    for (uint32_t s0 = 0; s0 < sc->n_scenarios; s0 += FORECAST_LANES) {
+        const uint32_t m = (sc->n_scenarios - s0 < FORECAST_LANES)
+                         ? sc->n_scenarios - s0 : FORECAST_LANES;
+
+        for (uint32_t j = 0; j < FORECAST_LANES; j++) {
+            b.soc[j] = ekf->soc;
+            b.v1[j] = ekf->v1;
+            b.v_min[j] = INFINITY;
+            b.live[j] = 1.0f;
+            b.n_live[j] = 0.0f;
+            b.hit_v0[j] = b.hit_v1[j] = 0.0f;
+            b.hit_s0[j] = b.hit_s1[j] = 0.0f;
+        }
+
+        for (uint32_t k = 0; k < sc->n_steps; k++) {
+            const float *cur = sc->current_A + (size_t)k * sc->ld + s0;
+
+            /* Partial last block runs on a zero-padded copy */
+            if (m < FORECAST_LANES) {
+                memset(pad, 0, sizeof(pad));
+                memcpy(pad, cur, m * sizeof(float));
+                cur = pad;
+            }
+
+            block_step(&b, cur, &coef);
+        }
+
+        if (out != NULL) {
+            if (out->tte_s != NULL) {
+                for (uint32_t j = 0; j < m; j++) out->tte_s[s0 + j] = crossing_time(&b, j, sc->dt_s);
+            }
+            if (out->v_min != NULL)   memcpy(out->v_min + s0, b.v_min, m * sizeof(float));
+            if (out->soc_end != NULL) {
+                for (uint32_t j = 0; j < m; j++) {
+                    const float soc = b.soc[j];
+                    out->soc_end[s0 + j] = (soc < SOC_MIN) ? SOC_MIN : (soc > SOC_MAX) ? SOC_MAX : soc;
+                }
+            }
+        }
+    }
+
+    return sc->n_scenarios;
+}
+
+void BMS_Forecast_SOP(const EKF_State *ekf,
+                      const float *horizons_s,
+                      uint32_t n_horizons,
+                      BMS_SOP_Result *out)
+{
+    if (ekf == NULL || horizons_s == NULL || out == NULL) return;
+
+    const float tau = R1 * C1;
+    const float capacity_as = NOMINAL_CAPACITY * 3600.0f;
+    const float ocv0 = ocv_from_soc(ekf->soc);
+
+    for (uint32_t h = 0; h < n_horizons; h++) {
+        const float H = (horizons_s[h] > 0.0f) ? horizons_s[h] : 0.0f;
+        const float a = (tau > 1e-9f) ? expf(-H / tau) : 0.0f;
+
+        /*
+          At constant discharge I, V(t) = A(t) - I * B(t). V is monotone
+          or concave in t, so its minimum over [0, H] is at an endpoint.
+        */
+        const float A0 = ocv0 - ekf->v1;
+        const float B0 = R0;
+        const float AH = ocv0 - ekf->v1 * a;
+        const float BH = FORECAST_OCV_SLOPE * H / capacity_as + R1 * (1.0f - a) + R0;
+
+        float I_v = (A0 - VOLTAGE_MIN) / B0;
+        const float I_vH = (AH - VOLTAGE_MIN) / BH;
+        if (I_vH < I_v) I_v = I_vH;
+
+        const float I_soc = (H > 0.0f) ? (ekf->soc - SOC_MIN) * capacity_as / H : INFINITY;
+
+        float I = CURRENT_MAX;
+        SOP_Limit_t limit = SOP_LIMIT_CURRENT;
+        if (I_v < I) {
+            I = I_v;
+            limit = SOP_LIMIT_VOLTAGE;
+        }
+        if (I_soc < I) {
+            I = I_soc;
+            limit = SOP_LIMIT_SOC;
+        }
+        if (I < 0.0f) I = 0.0f;
+
+        const float v0 = A0 - I * B0;
+        const float vH = AH - I * BH;
+
+        out[h].horizon_s = H;
+        out[h].current_A = I;
+        out[h].v_min = (v0 < vH) ? v0 : vH;
+        out[h].power_W = I * out[h].v_min;
+        out[h].limit = limit;
+    }
+}
+
+void BMS_Forecast_SOPDefault(const EKF_State *ekf, BMS_SOP_Result out[3])
+{
+    static const float horizons[3] = {
+        FORECAST_HORIZON_1_S, FORECAST_HORIZON_2_S, FORECAST_HORIZON_3_S
+    };
+    BMS_Forecast_SOP(ekf, horizons, 3u, out);
+}
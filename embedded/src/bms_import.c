@@ -0,0 +1,424 @@
+#include "bms_import.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define IMPORT_MAX_COLS      (64)
+#define IMPORT_MAX_NAME      (48)
+#define IMPORT_DEFAULT_TEMP  (25.0)
+#define IMPORT_INIT_CAP      (4096u)
+#define IMPORT_RAMP_BLOCK    (8)        /* floats per vectorized resample block */
+
+/* Column aliases in priority order, as in import_nasa.m */
+static const char *const time_names[] = { "time", "time_s", "t", "timestamp", "seconds", "t_s", NULL };
+static const char *const v_charge[]    = { "Voltage_measured", "Voltage_charge", "voltage", "v", NULL };
+static const char *const v_other[]     = { "Voltage_measured", "Voltage_load", "voltage", "v", NULL };
+static const char *const i_charge[]    = { "Current_measured", "Current_charge", "current", "i", NULL };
+static const char *const i_discharge[] = { "Current_measured", "Current_load", "current", "i", NULL };
+static const char *const i_impedance[] = { "Current_measured", "current", "i", NULL };
+static const char *const temp_names[]  = { "Temperature_measured", "temperature", "temp", "t_c", "t_celsius", NULL };
+
+typedef struct {
+    char names[IMPORT_MAX_COLS][IMPORT_MAX_NAME];
+    int  n;
+} Header;
+
+/* ---------- Header ---------- */
+
+static bool is_trim(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '"';
+}
+
+static int lower_c(int c)
+{
+    return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+}
+
+static bool name_eq(const char *a, const char *b)
+{
+    while (*a && *b) {
+        if (lower_c((unsigned char)*a) != lower_c((unsigned char)*b)) return false;
+        a++;
+        b++;
+    }
+    return *a == *b;
+}
+
+/* Parse the header line; returns offset of the first data line */
+static size_t parse_header(const char *text, size_t len, Header *hdr)
+{
+    size_t p = 0;
+    hdr->n = 0;
+
+    while (p < len && text[p] != '\n') {
+        size_t s = p;
+        while (p < len && text[p] != ',' && text[p] != '\n') p++;
+        size_t e = p;
+
+        while (s < e && is_trim(text[s])) s++;
+        while (e > s && is_trim(text[e - 1])) e--;
+
+        if (hdr->n < IMPORT_MAX_COLS) {
+            size_t l = e - s;
+            if (l >= IMPORT_MAX_NAME) l = IMPORT_MAX_NAME - 1u;
+            memcpy(hdr->names[hdr->n], text + s, l);
+            hdr->names[hdr->n][l] = '\0';
+            hdr->n++;
+        }
+
+        if (p < len && text[p] == ',') p++;
+    }
+
+    return (p < len) ? p + 1u : p;
+}
+
+static int find_col(const Header *hdr, const char *const *aliases)
+{
+    for (int a = 0; aliases[a] != NULL; a++) {
+        for (int c = 0; c < hdr->n; c++) {
+            if (name_eq(hdr->names[c], aliases[a])) return c;
+        }
+    }
+    return -1;
+}
+
+/* ---------- Numbers ---------- */
+
+static const double pow10_tab[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static double scale10(double m, int e)
+{
+    if (e >= 0) return (e <= 22) ? m * pow10_tab[e] : m * pow(10.0, e);
+    return (e >= -22) ? m / pow10_tab[-e] : m * pow(10.0, e);
+}
+
+/*
+  Plain decimal / scientific float. Returns false for empty, NaN, Inf
+  or malformed fields (all of which import_nasa.m drops).
+*/
+static bool parse_num(const char *s, const char *e, double *out)
+{
+    while (s < e && is_trim(*s)) s++;
+    while (e > s && is_trim(e[-1])) e--;
+    if (s == e) return false;
+
+    bool neg = false;
+    if (*s == '+' || *s == '-') {
+        neg = (*s == '-');
+        s++;
+    }
+
+    uint64_t mant = 0u;
+    int exp10 = 0;
+    int digits = 0;
+
+    while (s < e && *s >= '0' && *s <= '9') {
+        if (mant < 1000000000000000000ull) mant = mant * 10u + (uint64_t)(*s - '0');
+        else                               exp10++;
+        digits++;
+        s++;
+    }
+    if (s < e && *s == '.') {
+        s++;
+        while (s < e && *s >= '0' && *s <= '9') {
+            if (mant < 1000000000000000000ull) {
+                mant = mant * 10u + (uint64_t)(*s - '0');
+                exp10--;
+            }
+            digits++;
+            s++;
+        }
+    }
+    if (digits == 0) return false;
+
+    if (s < e && (*s == 'e' || *s == 'E')) {
+        s++;
+        bool eneg = false;
+        if (s < e && (*s == '+' || *s == '-')) {
+            eneg = (*s == '-');
+            s++;
+        }
+        int ev = 0;
+        int edigits = 0;
+        while (s < e && *s >= '0' && *s <= '9') {
+            if (ev < 10000) ev = ev * 10 + (*s - '0');
+            edigits++;
+            s++;
+        }
+        if (edigits == 0) return false;
+        exp10 += eneg ? -ev : ev;
+    }
+    if (s != e) return false;
+
+    const double v = scale10((double)mant, exp10);
+    *out = neg ? -v : v;
+    return isfinite(*out);
+}
+
+/* ---------- Result buffers ---------- */
+
+void BMS_Import_ResultInit(BMS_Import_Result *res)
+{
+    if (res == NULL) return;
+    memset(res, 0, sizeof(*res));
+}
+
+void BMS_Import_ResultFree(BMS_Import_Result *res)
+{
+    if (res == NULL) return;
+    free(res->V);
+    free(res->I);
+    free(res->T);
+    BMS_Import_ResultInit(res);
+}
+
+static bool ensure_cap(BMS_Import_Result *res, size_t need)
+{
+    if (need <= res->cap) return true;
+
+    size_t cap = (res->cap > 0u) ? res->cap : IMPORT_INIT_CAP;
+    while (cap < need) cap *= 2u;
+
+    float *v = realloc(res->V, cap * sizeof(float));
+    if (v == NULL) return false;
+    res->V = v;
+    float *i = realloc(res->I, cap * sizeof(float));
+    if (i == NULL) return false;
+    res->I = i;
+    float *t = realloc(res->T, cap * sizeof(float));
+    if (t == NULL) return false;
+    res->T = t;
+
+    res->cap = cap;
+    return true;
+}
+
+/* ---------- Streaming resampler ---------- */
+
+typedef struct {
+    double t, v, i, temp;
+} Sample;
+
+/*
+  y[j] = y0 + dy * j over one contiguous float column. The body is
+  float with a signed index, in blocks of fixed length: gcc 12 at -O2
+  only vectorizes loops that need no scalar epilogue, and does not
+  vectorize double -> float or size_t -> float conversions here.
+  Check with -fopt-info-vec.
+*/
+static void ramp(float *restrict y, int32_t m, float y0, float dy)
+{
+    int32_t j0 = 0;
+    for (; j0 + IMPORT_RAMP_BLOCK <= m; j0 += IMPORT_RAMP_BLOCK) {
+        for (int32_t j = 0; j < IMPORT_RAMP_BLOCK; j++) {
+            y[j0 + j] = y0 + dy * (float)(j0 + j);
+        }
+    }
+    for (int32_t j = j0; j < m; j++) {
+        y[j] = y0 + dy * (float)j;
+    }
+}
+
+/*
+  Emit grid points k in [k_from, k_to) on the line through a -> b.
+  Start values and per-step increments are computed once in double,
+  the points themselves are float ramps.
+*/
+static bool emit_line(BMS_Import_Result *res, double g0, double dt,
+                      size_t k_from, size_t k_to,
+                      const Sample *a, const Sample *b)
+{
+    if (k_to <= k_from) return true;
+
+    const size_t m = k_to - k_from;
+    if (m > (size_t)INT32_MAX) return false;
+    if (!ensure_cap(res, res->n + m)) return false;
+
+    const double inv = 1.0 / (b->t - a->t);
+    const double sv = (b->v - a->v) * inv;
+    const double si = (b->i - a->i) * inv;
+    const double st = (b->temp - a->temp) * inv;
+    const double x0 = g0 + (double)k_from * dt - a->t;
+
+    ramp(res->V + res->n, (int32_t)m, (float)(a->v + sv * x0),    (float)(sv * dt));
+    ramp(res->I + res->n, (int32_t)m, (float)(a->i + si * x0),    (float)(si * dt));
+    ramp(res->T + res->n, (int32_t)m, (float)(a->temp + st * x0), (float)(st * dt));
+
+    res->n += m;
+    return true;
+}
+
+/* ---------- Import ---------- */
+
+BMS_Import_Status_t BMS_Import_CSV(const char *text,
+                                   size_t len,
+                                   BMS_Cycle_Type type,
+                                   float dt_s,
+                                   BMS_Import_Result *res)
+{
+    if (text == NULL || res == NULL || !(dt_s > 0.0f)) return IMPORT_ERR_TOO_FEW;
+
+    Header hdr;
+    size_t p = parse_header(text, len, &hdr);
+
+    /* Resolve cycle type once per file */
+    if (type == BMS_CYCLE_AUTO) {
+        static const char *const charge_marks[] = { "Current_charge", "Voltage_charge", NULL };
+        static const char *const load_marks[]   = { "Current_load", "Voltage_load", NULL };
+        if (find_col(&hdr, charge_marks) >= 0)      type = BMS_CYCLE_CHARGE;
+        else if (find_col(&hdr, load_marks) >= 0)   type = BMS_CYCLE_DISCHARGE;
+        else                                        type = BMS_CYCLE_IMPEDANCE;
+    }
+
+    const char *const *v_names = (type == BMS_CYCLE_CHARGE) ? v_charge : v_other;
+    const char *const *i_names = (type == BMS_CYCLE_CHARGE)    ? i_charge
+                               : (type == BMS_CYCLE_DISCHARGE) ? i_discharge
+                               : i_impedance;
+
+    res->n = 0u;
+    res->type = type;
+    res->dt_s = dt_s;
+    res->t_start_s = 0.0;
+    res->rows_raw = res->rows_valid = res->rows_missing = res->rows_order = 0u;
+    res->col_time    = find_col(&hdr, time_names);
+    res->col_voltage = find_col(&hdr, v_names);
+    res->col_current = find_col(&hdr, i_names);
+    res->col_temp    = find_col(&hdr, temp_names);
+
+    if (res->col_time < 0)    return IMPORT_ERR_NO_TIME;
+    if (res->col_voltage < 0) return IMPORT_ERR_NO_VOLTAGE;
+    if (res->col_current < 0 && type != BMS_CYCLE_IMPEDANCE) return IMPORT_ERR_NO_CURRENT;
+
+    const double dt = (double)dt_s;
+    Sample prev = { 0.0, 0.0, 0.0, 0.0 };
+    Sample last = { 0.0, 0.0, 0.0, 0.0 };
+    double g0 = 0.0;
+    size_t k = 0u;
+
+    while (p < len) {
+        /* Skip blank lines */
+        if (text[p] == '\n' || text[p] == '\r') {
+            p++;
+            continue;
+        }
+
+        Sample s = { 0.0, 0.0, 0.0, IMPORT_DEFAULT_TEMP };
+        bool ok = true;
+        int f = 0;
+
+        /* Walk every field: rmmissing drops a row with any missing value */
+        for (;;) {
+            const size_t fs = p;
+            while (p < len && text[p] != ',' && text[p] != '\n') p++;
+
+            double val;
+            const bool num = parse_num(text + fs, text + p, &val);
+            if (!num) ok = false;
+            else if (f == res->col_time)    s.t = val;
+            else if (f == res->col_voltage) s.v = val;
+            else if (f == res->col_current) s.i = val;
+            else if (f == res->col_temp)    s.temp = val;
+
+            f++;
+            if (p >= len || text[p] == '\n') break;
+            p++;
+        }
+        if (p < len) p++;   /* past '\n' */
+
+        res->rows_raw++;
+        if (!ok || f < hdr.n) {
+            res->rows_missing++;
+            continue;
+        }
+
+        if (type == BMS_CYCLE_CHARGE)         s.i = fabs(s.i);
+        else if (type == BMS_CYCLE_DISCHARGE) s.i = -fabs(s.i);
+
+        if (res->rows_valid == 0u) {
+            g0 = floor(s.t);
+            prev = s;
+            last = s;
+            res->rows_valid++;
+            continue;
+        }
+
+        if (!(s.t > last.t)) {
+            res->rows_order++;
+            continue;
+        }
+
+        /* Grid points before s.t come from the segment last -> s */
+        const size_t k_end = (size_t)ceil((s.t - g0) / dt);
+        if (!emit_line(res, g0, dt, k, k_end, &last, &s)) return IMPORT_ERR_NOMEM;
+        if (k_end > k) k = k_end;
+
+        prev = last;
+        last = s;
+        res->rows_valid++;
+    }
+
+    if (res->rows_valid < 2u) return IMPORT_ERR_TOO_FEW;
+
+    /* Tail up to ceil(tN), extrapolating the last segment */
+    const double t_end = ceil(last.t);
+    const size_t k_last = (size_t)floor((t_end - g0) / dt + 1e-9);
+    if (!emit_line(res, g0, dt, k, k_last + 1u, &prev, &last)) return IMPORT_ERR_NOMEM;
+
+    res->t_start_s = g0;
+    return IMPORT_OK;
+}
+
+const char* BMS_Import_StatusString(BMS_Import_Status_t status)
+{
+    switch (status) {
+        case IMPORT_OK:             return "OK";
+        case IMPORT_ERR_NO_TIME:    return "no time column";
+        case IMPORT_ERR_NO_VOLTAGE: return "no voltage column";
+        case IMPORT_ERR_NO_CURRENT: return "no current column";
+        case IMPORT_ERR_TOO_FEW:    return "fewer than 2 valid rows";
+        case IMPORT_ERR_NOMEM:      return "out of memory";
+        default:                    return "UNKNOWN";
+    }
+}
+
+/* ---------- Binary cycle file ---------- */
+
+size_t BMS_Cycle_FileSize(uint32_t n_samples)
+{
+    return sizeof(BMS_Cycle_Header) + 3u * (size_t)n_samples * sizeof(float);
+}
+
+void BMS_Cycle_FillHeader(BMS_Cycle_Header *hdr, const BMS_Import_Result *res)
+{
+    if (hdr == NULL || res == NULL) return;
+
+    memset(hdr, 0, sizeof(*hdr));
+    hdr->magic      = BMS_CYCLE_MAGIC;
+    hdr->version    = BMS_CYCLE_VERSION;
+    hdr->cycle_type = (uint8_t)res->type;
+    hdr->n_samples  = (uint32_t)res->n;
+    hdr->dt_s       = res->dt_s;
+    hdr->t_start_s  = res->t_start_s;
+    hdr->rows_raw   = res->rows_raw;
+    hdr->rows_valid = res->rows_valid;
+}
+
+bool BMS_Cycle_Open(const void *mem, size_t bytes, BMS_Cycle_View *view)
+{
+    if (mem == NULL || view == NULL || bytes < sizeof(BMS_Cycle_Header)) return false;
+
+    const BMS_Cycle_Header *hdr = (const BMS_Cycle_Header *)mem;
+    if (hdr->magic != BMS_CYCLE_MAGIC || hdr->version != BMS_CYCLE_VERSION) return false;
+    if (bytes < BMS_Cycle_FileSize(hdr->n_samples)) return false;
+
+    const float *cols = (const float *)(hdr + 1);
+    view->hdr = hdr;
+    view->V = cols;
+    view->I = cols + hdr->n_samples;
+    view->T = cols + 2u * (size_t)hdr->n_samples;
+    return true;
+}
@@ -0,0 +1,358 @@
+#include "bms_ingest.h"
+#include "bms_batch.h"
+#include "bms_config.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define INGEST_ALIGN      (8u)
+#define INGEST_MASK_WORDS (INGEST_MAX_CELLS_PER_PACK / 64u)
+
+/* One pack: columns for the tick being assembled + batch estimator */
+typedef struct {
+    uint32_t tick;                 /* tick being assembled */
+    uint32_t received;             /* cells received for this tick */
+    bool     started;              /* any tick seen yet */
+    uint64_t rx_mask[INGEST_MASK_WORDS];
+
+    /* Input columns, one entry per cell (BMS_Batch ld = 1) */
+    double   time_s[INGEST_MAX_CELLS_PER_PACK];
+    float    current_A[INGEST_MAX_CELLS_PER_PACK];
+    float    voltage_V[INGEST_MAX_CELLS_PER_PACK];
+    float    temp_C[INGEST_MAX_CELLS_PER_PACK];
+    uint8_t  valid[INGEST_MAX_CELLS_PER_PACK];   /* rx_mask as a batch column */
+    uint64_t send_ns[INGEST_MAX_CELLS_PER_PACK];
+
+    /* Output columns */
+    float    soc[INGEST_MAX_CELLS_PER_PACK];
+    uint8_t  faults[INGEST_MAX_CELLS_PER_PACK];
+
+    BMS_Batch *batch;              /* state placed right after this struct */
+} Ingest_Pack;
+
+struct Ingest_Engine {
+    uint32_t      n_packs;
+    uint32_t      cells_per_pack;
+    size_t        pack_stride;
+    Ingest_TimeFn now_ns;
+    Ingest_Stats  stats;
+    uint32_t      lat_hist[INGEST_LAT_BUCKETS];   /* 1 us bins */
+};
+
+static size_t align_up(size_t x)
+{
+    return (x + (INGEST_ALIGN - 1u)) & ~(size_t)(INGEST_ALIGN - 1u);
+}
+
+static size_t pack_stride(uint32_t cells_per_pack)
+{
+    return align_up(align_up(sizeof(Ingest_Pack)) + BMS_Batch_StateSize(cells_per_pack));
+}
+
+static Ingest_Pack* pack_at(const Ingest_Engine *eng, uint32_t p)
+{
+    uint8_t *base = (uint8_t *)eng + align_up(sizeof(Ingest_Engine));
+    return (Ingest_Pack *)(base + (size_t)p * eng->pack_stride);
+}
+
+/* ---------- Wire helpers (explicit little-endian) ---------- */
+
+static uint16_t rd_u16(const uint8_t *b)
+{
+    return (uint16_t)((uint16_t)b[0] | ((uint16_t)b[1] << 8));
+}
+
+static uint32_t rd_u32(const uint8_t *b)
+{
+    return (uint32_t)b[0] | ((uint32_t)b[1] << 8) |
+           ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+static uint64_t rd_u64(const uint8_t *b)
+{
+    return (uint64_t)rd_u32(b) | ((uint64_t)rd_u32(b + 4) << 32);
+}
+
+static float rd_f32(const uint8_t *b)
+{
+    const uint32_t u = rd_u32(b);
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+static double rd_f64(const uint8_t *b)
+{
+    const uint64_t u = rd_u64(b);
+    double d;
+    memcpy(&d, &u, sizeof(d));
+    return d;
+}
+
+static void wr_u16(uint8_t *b, uint16_t v)
+{
+    b[0] = (uint8_t)v;
+    b[1] = (uint8_t)(v >> 8);
+}
+
+static void wr_u32(uint8_t *b, uint32_t v)
+{
+    b[0] = (uint8_t)v;
+    b[1] = (uint8_t)(v >> 8);
+    b[2] = (uint8_t)(v >> 16);
+    b[3] = (uint8_t)(v >> 24);
+}
+
+static void wr_u64(uint8_t *b, uint64_t v)
+{
+    wr_u32(b, (uint32_t)v);
+    wr_u32(b + 4, (uint32_t)(v >> 32));
+}
+
+static void wr_f32(uint8_t *b, float f)
+{
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    wr_u32(b, u);
+}
+
+static void wr_f64(uint8_t *b, double d)
+{
+    uint64_t u;
+    memcpy(&u, &d, sizeof(u));
+    wr_u64(b, u);
+}
+
+/* ---------- Engine ---------- */
+
+size_t Ingest_StateSize(uint32_t n_packs, uint32_t cells_per_pack)
+{
+    return align_up(sizeof(Ingest_Engine)) + (size_t)n_packs * pack_stride(cells_per_pack);
+}
+
+Ingest_Engine* Ingest_Init(void *mem, size_t mem_bytes,
+                           uint32_t n_packs,
+                           uint32_t cells_per_pack,
+                           float init_soc,
+                           Ingest_TimeFn now_ns)
+{
+    if (mem == NULL || n_packs == 0u) return NULL;
+    if (cells_per_pack == 0u || cells_per_pack > INGEST_MAX_CELLS_PER_PACK) return NULL;
+    if (((uintptr_t)mem % INGEST_ALIGN) != 0u) return NULL;
+    if (mem_bytes < Ingest_StateSize(n_packs, cells_per_pack)) return NULL;
+
+    Ingest_Engine *eng = (Ingest_Engine *)mem;
+    memset(eng, 0, sizeof(*eng));
+    eng->n_packs = n_packs;
+    eng->cells_per_pack = cells_per_pack;
+    eng->pack_stride = pack_stride(cells_per_pack);
+    eng->now_ns = now_ns;
+
+    for (uint32_t p = 0; p < n_packs; p++) {
+        Ingest_Pack *pack = pack_at(eng, p);
+        memset(pack, 0, sizeof(*pack));
+
+        void *batch_mem = (uint8_t *)pack + align_up(sizeof(Ingest_Pack));
+        pack->batch = BMS_Batch_Init(batch_mem, BMS_Batch_StateSize(cells_per_pack),
+                                     cells_per_pack, init_soc);
+        if (pack->batch == NULL) return NULL;
+
+        for (uint32_t c = 0; c < cells_per_pack; c++) {
+            pack->soc[c] = init_soc;
+        }
+    }
+
+    return eng;
+}
+
+static void record_latency(Ingest_Engine *eng, uint64_t lat_ns)
+{
+    const uint64_t bin = lat_ns / 1000u;
+    if (bin < INGEST_LAT_BUCKETS) eng->lat_hist[bin]++;
+    else                          eng->stats.lat_overflow++;
+    if (lat_ns > eng->stats.lat_max_ns) eng->stats.lat_max_ns = lat_ns;
+    eng->stats.lat_count++;
+}
+
+/* Run the estimators for the assembled tick and open the next one */
+static void run_tick(Ingest_Engine *eng, Ingest_Pack *pack)
+{
+    /* Cells without a frame are skipped; their next sample spans the gap */
+    BMS_Batch_Input in = { pack->time_s, pack->current_A, pack->voltage_V, pack->temp_C,
+                           pack->valid };
+    BMS_Batch_Output out = { pack->soc, NULL, NULL, NULL, pack->faults };
+
+    BMS_Batch_Run(pack->batch, &in, &out, 1u, 1u);
+
+    if (pack->received == eng->cells_per_pack) eng->stats.ticks_done++;
+    else                                       eng->stats.ticks_incomplete++;
+
+    if (eng->now_ns != NULL) {
+        const uint64_t done = eng->now_ns();
+        for (uint32_t w = 0; w < INGEST_MASK_WORDS; w++) {
+            uint64_t bits = pack->rx_mask[w];
+            while (bits != 0u) {
+                const uint32_t c = w * 64u + (uint32_t)__builtin_ctzll(bits);
+                bits &= bits - 1u;
+                const uint64_t sent = pack->send_ns[c];
+                record_latency(eng, (done > sent) ? (done - sent) : 0u);
+            }
+        }
+    }
+
+    pack->tick++;
+    pack->received = 0u;
+    memset(pack->rx_mask, 0, sizeof(pack->rx_mask));
+    memset(pack->valid, 0, eng->cells_per_pack);
+}
+
+Ingest_Result_t Ingest_Frame(Ingest_Engine *eng,
+                             const uint8_t *buf,
+                             size_t len)
+{
+    if (eng == NULL || buf == NULL) return INGEST_ERR_FRAME;
+
+    if (len != INGEST_FRAME_SIZE ||
+        rd_u16(buf) != INGEST_FRAME_MAGIC ||
+        buf[2] != INGEST_FRAME_VERSION) {
+        eng->stats.frames_bad++;
+        return INGEST_ERR_FRAME;
+    }
+
+    const uint8_t flags = buf[3];
+    const uint32_t tick = rd_u32(buf + 8);
+
+    if (flags & INGEST_FLAG_END) {
+        eng->stats.end_frames_sent = tick;
+        return INGEST_END;
+    }
+
+    const uint16_t pack_id = rd_u16(buf + 4);
+    const uint16_t cell = rd_u16(buf + 6);
+    if (pack_id >= eng->n_packs || cell >= eng->cells_per_pack) {
+        eng->stats.frames_bad++;
+        return INGEST_ERR_RANGE;
+    }
+
+    Ingest_Pack *pack = pack_at(eng, pack_id);
+    Ingest_Result_t result = INGEST_OK;
+
+    if (!pack->started) {
+        pack->started = true;
+        pack->tick = tick;
+    } else if ((int32_t)(tick - pack->tick) < 0) {
+        eng->stats.frames_late++;
+        return INGEST_LATE;
+    } else if (tick != pack->tick) {
+        /* Newer tick: flush what we have, missing cells are not stepped */
+        if (pack->received > 0u) {
+            run_tick(eng, pack);
+            result = INGEST_TICK_DONE;
+        }
+        pack->tick = tick;
+    }
+
+    const uint32_t w = (uint32_t)cell / 64u;
+    const uint64_t bit = (uint64_t)1u << ((uint32_t)cell % 64u);
+    if (pack->rx_mask[w] & bit) {
+        eng->stats.frames_dup++;
+        return INGEST_DUPLICATE;
+    }
+
+    /* Decode straight into the pack columns */
+    pack->time_s[cell]    = rd_f64(buf + 12);
+    pack->current_A[cell] = rd_f32(buf + 20);
+    pack->voltage_V[cell] = rd_f32(buf + 24);
+    pack->temp_C[cell]    = rd_f32(buf + 28);
+    pack->send_ns[cell]   = rd_u64(buf + 32);
+    pack->valid[cell]     = 1u;
+
+    pack->rx_mask[w] |= bit;
+    pack->received++;
+    eng->stats.frames_ok++;
+
+    if (pack->received == eng->cells_per_pack) {
+        run_tick(eng, pack);
+        result = INGEST_TICK_DONE;
+    }
+
+    return result;
+}
+
+uint32_t Ingest_FlushTick(Ingest_Engine *eng)
+{
+    if (eng == NULL) return 0u;
+
+    uint32_t flushed = 0u;
+    for (uint32_t p = 0; p < eng->n_packs; p++) {
+        Ingest_Pack *pack = pack_at(eng, p);
+        if (pack->received == 0u) continue;
+        run_tick(eng, pack);
+        flushed++;
+    }
+
+    return flushed;
+}
+
+void Ingest_EncodeFrame(uint8_t *buf,
+                        uint8_t flags,
+                        uint16_t pack_id,
+                        uint16_t cell_id,
+                        uint32_t tick,
+                        double time_s,
+                        float current_A,
+                        float voltage_V,
+                        float temp_C,
+                        uint64_t send_ns)
+{
+    if (buf == NULL) return;
+
+    wr_u16(buf + 0, INGEST_FRAME_MAGIC);
+    buf[2] = INGEST_FRAME_VERSION;
+    buf[3] = flags;
+    wr_u16(buf + 4, pack_id);
+    wr_u16(buf + 6, cell_id);
+    wr_u32(buf + 8, tick);
+    wr_f64(buf + 12, time_s);
+    wr_f32(buf + 20, current_A);
+    wr_f32(buf + 24, voltage_V);
+    wr_f32(buf + 28, temp_C);
+    wr_u64(buf + 32, send_ns);
+}
+
+const Ingest_Stats* Ingest_GetStats(const Ingest_Engine *eng)
+{
+    return (eng != NULL) ? &eng->stats : NULL;
+}
+
+uint64_t Ingest_LatencyPercentile(const Ingest_Engine *eng, float pct)
+{
+    if (eng == NULL || eng->stats.lat_count == 0u) return 0u;
+
+    if (pct < 0.0f) pct = 0.0f;
+    if (pct > 100.0f) pct = 100.0f;
+
+    uint64_t target = (uint64_t)((double)eng->stats.lat_count * (double)pct / 100.0);
+    if (target == 0u) target = 1u;
+
+    uint64_t seen = 0u;
+    for (uint32_t b = 0; b < INGEST_LAT_BUCKETS; b++) {
+        seen += eng->lat_hist[b];
+        if (seen >= target) return ((uint64_t)b + 1u) * 1000u;   /* bin upper edge */
+    }
+
+    /* Falls in overflow: report the worst seen */
+    return eng->stats.lat_max_ns;
+}
+
+float Ingest_GetSOC(const Ingest_Engine *eng, uint32_t pack, uint32_t cell)
+{
+    if (eng == NULL || pack >= eng->n_packs || cell >= eng->cells_per_pack) return 0.0f;
+    return pack_at(eng, pack)->soc[cell];
+}
+
+uint8_t Ingest_GetFaults(const Ingest_Engine *eng, uint32_t pack, uint32_t cell)
+{
+    if (eng == NULL || pack >= eng->n_packs || cell >= eng->cells_per_pack) return 0u;
+    return pack_at(eng, pack)->faults[cell];
+}
@@ -0,0 +1,159 @@
+#include "bms_lazy.h"
+#include "bms_config.h"
+#include <math.h>
+#include <stddef.h>
+
+/* Charge / discharge deadband used by SOH_Update and Safety_Check */
+#define LAZY_DIR_DEADBAND  (0.05f)
+
+/* SOH_CheckCycleComplete looks for end of discharge below this voltage */
+#define LAZY_SOH_EOD_V     (VOLTAGE_MIN + 0.1f)
+
+void BMS_Lazy_DefaultConfig(BMS_Lazy_Config *cfg)
+{
+    if (cfg == NULL) return;
+
+    cfg->i_band       = LAZY_I_BAND;
+    cfg->v_band       = LAZY_V_BAND;
+    cfg->t_band       = LAZY_T_BAND;
+    cfg->max_window_s = LAZY_MAX_WINDOW_S;
+}
+
+void BMS_Lazy_Init(BMS_Lazy_Cell *cell, float init_soc)
+{
+    if (cell == NULL) return;
+
+    BMS_Init(&cell->bms);
+    cell->bms.soc = init_soc;
+    EKF_Init(&cell->ekf, init_soc);
+    SOH_Init(&cell->soh, NOMINAL_CAPACITY);
+    Safety_Init(&cell->fsm);
+
+    cell->in_window = false;
+    cell->win_s = 0.0f;
+    cell->win_as = 0.0f;
+    cell->win_n = 0u;
+
+    cell->steps_exact = 0u;
+    cell->steps_deferred = 0u;
+    cell->flushes = 0u;
+}
+
+static void step_exact(BMS_Lazy_Cell *cell, float I, float V, float T, float dt)
+{
+    BMS_ECM_Step(&cell->bms, I, dt);
+    EKF_Predict(&cell->ekf, I, dt);
+    EKF_Update(&cell->ekf, V, I);
+    SOH_Update(&cell->soh, I, V, dt);
+    Safety_Check(&cell->fsm, V, I, T, cell->ekf.soc, dt);
+    cell->steps_exact++;
+}
+
+/*
+  Can a window start here? Every value reachable inside the bands must
+  leave Safety_Check and SOH_Update with nothing to do but advance time
+  and coulomb count, so the whole window can be applied in one call.
+*/
+static bool can_open(const BMS_Lazy_Cell *cell, const BMS_Lazy_Config *cfg,
+                     float I, float V, float T)
+{
+    const Safety_FSM *fsm = &cell->fsm;
+
+    switch (fsm->current_state) {
+        case BMS_STATE_NORMAL:
+        case BMS_STATE_CHARGING:
+        case BMS_STATE_DISCHARGING:
+            break;
+        default:
+            return false;
+    }
+    if (fsm->fault_flags != FAULT_NONE || fsm->debounce_armed != 0u) return false;
+
+    const float i_abs = fabsf(I);
+    if (i_abs + cfg->i_band >= CURRENT_MAX) return false;
+    if (fabsf(i_abs - LAZY_DIR_DEADBAND) <= cfg->i_band) return false;
+
+    if (V - cfg->v_band <= LAZY_SOH_EOD_V || V + cfg->v_band >= VOLTAGE_MAX) return false;
+    if (T - cfg->t_band <= TEMP_MIN || T + cfg->t_band >= TEMP_MAX) return false;
+
+    /* SOC must stay clear of SOC_LOW even if the whole window discharges */
+    const float soc_drift = (i_abs + cfg->i_band) * cfg->max_window_s / (NOMINAL_CAPACITY * 3600.0f);
+    if (cell->ekf.soc - soc_drift <= SOC_MIN + SAFETY_HYST_SOC) return false;
+
+    return true;
+}
+
+static void try_open(BMS_Lazy_Cell *cell, const BMS_Lazy_Config *cfg,
+                     float I, float V, float T)
+{
+    if (!can_open(cell, cfg, I, V, T)) return;
+
+    cell->in_window = true;
+    cell->i_first = I;
+    cell->v_first = V;
+    cell->t_first = T;
+}
+
+static bool in_band(const BMS_Lazy_Cell *cell, const BMS_Lazy_Config *cfg,
+                    float I, float V, float T)
+{
+    return fabsf(I - cell->i_first) <= cfg->i_band
+        && fabsf(V - cell->v_first) <= cfg->v_band
+        && fabsf(T - cell->t_first) <= cfg->t_band;
+}
+
+void BMS_Lazy_Flush(BMS_Lazy_Cell *cell)
+{
+    if (cell == NULL) return;
+
+    if (cell->in_window && cell->win_n > 0u) {
+        const float dt = cell->win_s;
+        const float I = cell->win_as / dt;
+        const float V = cell->v_last;
+
+        BMS_ECM_FastForward(&cell->bms, I, dt, cell->win_n);
+        EKF_FastForward(&cell->ekf, I, dt, cell->win_n);
+        EKF_Update(&cell->ekf, V, I);
+        SOH_Update(&cell->soh, I, V, dt);
+        Safety_Check(&cell->fsm, V, I, cell->temp_last, cell->ekf.soc, dt);
+        cell->flushes++;
+    }
+
+    cell->in_window = false;
+    cell->win_s = 0.0f;
+    cell->win_as = 0.0f;
+    cell->win_n = 0u;
+}
+
+bool BMS_Lazy_Step(BMS_Lazy_Cell *cell,
+                   const BMS_Lazy_Config *cfg,
+                   float current_A,
+                   float voltage_V,
+                   float temp_C,
+                   float dt_s)
+{
+    if (cell == NULL || cfg == NULL) return false;
+
+    if (cell->in_window && dt_s > 0.0f && in_band(cell, cfg, current_A, voltage_V, temp_C)) {
+        cell->win_s += dt_s;
+        cell->win_as += current_A * dt_s;
+        cell->win_n++;
+        cell->v_last = voltage_V;
+        cell->temp_last = temp_C;
+        cell->steps_deferred++;
+
+        if (cell->win_s >= cfg->max_window_s) {
+            BMS_Lazy_Flush(cell);
+            /* Continue with a fresh window anchored at this sample */
+            try_open(cell, cfg, current_A, voltage_V, temp_C);
+        }
+        return false;
+    }
+
+    /* Leaving the band (or no window): catch up, then step exactly */
+    BMS_Lazy_Flush(cell);
+    step_exact(cell, current_A, voltage_V, temp_C, dt_s);
+
+    try_open(cell, cfg, current_A, voltage_V, temp_C);
+    return true;
+}
@@ -67,6 +67,28 @@ void BMS_ECM_Step(BMS_State *state, float current, float dt)
     state->step_count++;
 }
 
+void BMS_ECM_FastForward(BMS_State *state, float current, float dt_total, uint32_t n_steps)
+{
+    if (state == NULL || dt_total <= 0.0f || n_steps == 0u) return;
+
+    const float i_eff = fabsf(current);
+    const float tau = R1 * C1;
+    const float alpha_n = (tau > 1e-6f) ? expf(-dt_total / tau) : 0.0f;
+
+    /* RC relaxation over the whole interval */
+    state->v1 = state->v1 * alpha_n + (i_eff * R1) * (1.0f - alpha_n);
+
+    const float capacity_coulombs = NOMINAL_CAPACITY * 3600.0f;
+    if (capacity_coulombs > 1e-12f) {
+        state->soc += (current * dt_total) / capacity_coulombs;
+        state->soc = clampf(state->soc, SOC_MIN, SOC_MAX);
+    }
+
+    state->v_terminal = ocv_from_soc(state->soc) - state->v1 - i_eff * R0;
+    state->i_prev = current;
+    state->step_count += n_steps;
+}
+
 float BMS_GetVoltage(const BMS_State *state, float current)
 {
     if (state == NULL) return 0.0f;
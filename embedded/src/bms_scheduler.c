@@ -0,0 +1,160 @@
+#include "bms_scheduler.h"
+#include <stddef.h>
+
+static uint32_t sched_now(const Scheduler *sched)
+{
+    return (sched->now_us != NULL) ? sched->now_us() : 0u;
+}
+
+void Sched_Init(Scheduler *sched, Sched_TimeFn now_us, uint32_t tick_budget_us)
+{
+    if (sched == NULL) return;
+
+    sched->n_tasks = 0u;
+    sched->tick = 0u;
+    sched->tick_budget_us = tick_budget_us;
+    sched->now_us = now_us;
+
+    sched->tick_overruns = 0u;
+    sched->last_tick_us = 0u;
+    sched->tick_wcet_us = 0u;
+}
+
+int Sched_AddTask(Scheduler *sched,
+                  const char *name,
+                  Sched_TaskFn fn,
+                  void *ctx,
+                  uint16_t period_ticks,
+                  uint16_t offset_ticks,
+                  uint8_t priority,
+                  uint32_t budget_us,
+                  bool critical)
+{
+    if (sched == NULL || fn == NULL) return -1;
+    if (sched->n_tasks >= SCHED_MAX_TASKS) return -1;
+    if (period_ticks > 0u && offset_ticks >= period_ticks) return -1;
+
+    const uint8_t id = sched->n_tasks;
+    Sched_Task *task = &sched->tasks[id];
+
+    task->name = name;
+    task->fn = fn;
+    task->ctx = ctx;
+    task->period_ticks = period_ticks;
+    task->offset_ticks = offset_ticks;
+    task->priority = priority;
+    task->critical = critical;
+    task->budget_us = budget_us;
+
+    task->pending = false;
+    task->last_run_tick = sched->tick;
+
+    task->run_count = 0u;
+    task->overrun_count = 0u;
+    task->shed_count = 0u;
+    task->last_us = 0u;
+    task->wcet_us = 0u;
+
+    /* Insertion sort into priority order; equal priority keeps add order */
+    uint8_t pos = sched->n_tasks;
+    while (pos > 0u && sched->tasks[sched->order[pos - 1u]].priority > priority) {
+        sched->order[pos] = sched->order[pos - 1u];
+        pos--;
+    }
+    sched->order[pos] = id;
+    sched->n_tasks++;
+
+    return (int)id;
+}
+
+void Sched_Trigger(Scheduler *sched, int task_id)
+{
+    if (sched == NULL || task_id < 0 || task_id >= (int)sched->n_tasks) return;
+    sched->tasks[task_id].pending = true;
+}
+
+uint32_t Sched_RunTick(Scheduler *sched)
+{
+    if (sched == NULL) return 0u;
+
+    const uint32_t t_tick = sched_now(sched);
+
+    /* Release periodic tasks due this tick */
+    for (uint8_t i = 0; i < sched->n_tasks; i++) {
+        Sched_Task *task = &sched->tasks[i];
+        if (task->period_ticks == 0u) continue;
+        if ((sched->tick % task->period_ticks) == task->offset_ticks) {
+            task->pending = true;
+        }
+    }
+
+    /*
+      Dispatch in priority order. Once a task is shed, everything below
+      it that is not critical is shed too, so cheaper low-priority work
+      cannot take the slack a higher-priority task was waiting for.
+    */
+    bool shedding = false;
+    for (uint8_t n = 0; n < sched->n_tasks; n++) {
+        Sched_Task *task = &sched->tasks[sched->order[n]];
+        if (!task->pending) continue;
+
+        const uint32_t t_start = sched_now(sched);
+
+        /* Shed non-critical work that would not fit in what is left */
+        if (!task->critical && !shedding && sched->tick_budget_us > 0u && sched->now_us != NULL) {
+            const uint32_t used = t_start - t_tick;
+            shedding = (used + task->budget_us > sched->tick_budget_us);
+        }
+        if (!task->critical && shedding) {
+            task->shed_count++;
+            continue;   /* stays pending, retried next tick */
+        }
+
+        /* Ticks since last run, including this one */
+        const uint32_t elapsed = sched->tick + 1u - task->last_run_tick;
+
+        task->fn(task->ctx, elapsed);
+
+        const uint32_t t_end = sched_now(sched);
+        const uint32_t exec = t_end - t_start;
+
+        task->pending = false;
+        task->last_run_tick = sched->tick + 1u;
+        task->run_count++;
+        task->last_us = exec;
+        if (exec > task->wcet_us) task->wcet_us = exec;
+        if (task->budget_us > 0u && exec > task->budget_us) task->overrun_count++;
+    }
+
+    const uint32_t tick_us = sched_now(sched) - t_tick;
+    sched->last_tick_us = tick_us;
+    if (tick_us > sched->tick_wcet_us) sched->tick_wcet_us = tick_us;
+    if (sched->tick_budget_us > 0u && tick_us > sched->tick_budget_us) sched->tick_overruns++;
+
+    sched->tick++;
+    return tick_us;
+}
+
+const Sched_Task* Sched_GetTask(const Scheduler *sched, int task_id)
+{
+    if (sched == NULL || task_id < 0 || task_id >= (int)sched->n_tasks) return NULL;
+    return &sched->tasks[task_id];
+}
+
+void Sched_ResetStats(Scheduler *sched)
+{
+    if (sched == NULL) return;
+
+    for (uint8_t i = 0; i < sched->n_tasks; i++) {
+        Sched_Task *task = &sched->tasks[i];
+        task->run_count = 0u;
+        task->overrun_count = 0u;
+        task->shed_count = 0u;
+        task->last_us = 0u;
+        task->wcet_us = 0u;
+    }
+
+    sched->tick_overruns = 0u;
+    sched->last_tick_us = 0u;
+    sched->tick_wcet_us = 0u;
+}
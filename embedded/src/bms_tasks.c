@@ -0,0 +1,152 @@
+#include "bms_tasks.h"
+#include "bms_config.h"
+#include <stddef.h>
+
+/* Direction deadband and end-of-discharge window as in soh_estimator.c */
+#define TASK_SOH_DEADBAND_A  (0.05f)
+#define TASK_SOH_END_V       (VOLTAGE_MIN + 0.1f)
+
+static void task_safety(void *ctx, uint32_t ticks_elapsed)
+{
+    BMS_Pack *pack = (BMS_Pack *)ctx;
+    const float dt = (float)ticks_elapsed * pack->tick_dt_s;
+    bool cycle_end = false;
+
+    for (uint32_t c = 0; c < pack->n_cells; c++) {
+        const float I = pack->current_A[c];
+        const float V = pack->voltage_V[c];
+
+        Safety_Check(&pack->fsm[c], V, I,
+                     pack->temp_C[c],
+                     pack->ekf[c].soc,
+                     dt);
+
+        /* Integrate every sample for the slower tasks */
+        BMS_Cell_Acc *acc = &pack->acc[c];
+        acc->ecm_As += I * dt;
+        acc->ekf_As += I * dt;
+        if (I < -TASK_SOH_DEADBAND_A) acc->soh_As -= I * dt;
+
+        /* End of discharge: not charging, near VOLTAGE_MIN, voltage recovering */
+        if (I <= TASK_SOH_DEADBAND_A && V <= TASK_SOH_END_V && V > acc->v_prev) {
+            if (!acc->cycle_end) acc->cycle_As = 0.0f;
+            acc->cycle_As += acc->soh_As;
+            acc->soh_As = 0.0f;
+            acc->cycle_I = I;
+            acc->cycle_v = V;
+            acc->cycle_v_prev = acc->v_prev;
+            acc->cycle_end = true;
+            cycle_end = true;
+        }
+        acc->v_prev = V;
+    }
+
+    if (cycle_end) Sched_Trigger(pack->sched, pack->soh_task);
+}
+
+static void task_ekf(void *ctx, uint32_t ticks_elapsed)
+{
+    BMS_Pack *pack = (BMS_Pack *)ctx;
+    const float dt = (float)ticks_elapsed * pack->tick_dt_s;
+
+    for (uint32_t c = 0; c < pack->n_cells; c++) {
+        const float I_mean = (dt > 0.0f) ? pack->acc[c].ekf_As / dt : pack->current_A[c];
+        pack->acc[c].ekf_As = 0.0f;
+
+        EKF_Predict(&pack->ekf[c], I_mean, dt);
+        EKF_Update(&pack->ekf[c], pack->voltage_V[c], pack->current_A[c]);
+    }
+}
+
+static void task_ecm(void *ctx, uint32_t ticks_elapsed)
+{
+    BMS_Pack *pack = (BMS_Pack *)ctx;
+    const float dt = (float)ticks_elapsed * pack->tick_dt_s;
+
+    for (uint32_t c = 0; c < pack->n_cells; c++) {
+        const float I_mean = (dt > 0.0f) ? pack->acc[c].ecm_As / dt : pack->current_A[c];
+        pack->acc[c].ecm_As = 0.0f;
+
+        BMS_ECM_Step(&pack->bms[c], I_mean, dt);
+    }
+}
+
+static void task_soh(void *ctx, uint32_t ticks_elapsed)
+{
+    BMS_Pack *pack = (BMS_Pack *)ctx;
+    (void)ticks_elapsed;
+
+    /* Only cells whose discharge ended since the last run */
+    for (uint32_t c = 0; c < pack->n_cells; c++) {
+        BMS_Cell_Acc *acc = &pack->acc[c];
+        if (!acc->cycle_end) continue;
+
+        SOH_UpdateWindow(&pack->soh[c], acc->cycle_As, acc->cycle_I,
+                         acc->cycle_v, acc->cycle_v_prev);
+        acc->cycle_end = false;
+    }
+}
+
+void BMS_Tasks_DefaultConfig(BMS_Task_Config *cfg)
+{
+    if (cfg == NULL) return;
+
+    cfg->period_ticks[BMS_TASK_SAFETY] = SCHED_RATE_SAFETY;
+    cfg->period_ticks[BMS_TASK_EKF]    = SCHED_RATE_EKF;
+    cfg->period_ticks[BMS_TASK_ECM]    = SCHED_RATE_ECM;
+    cfg->period_ticks[BMS_TASK_SOH]    = SCHED_RATE_SOH;
+
+    for (int i = 0; i < BMS_TASK_COUNT; i++) {
+        cfg->budget_us[i] = 0u;
+    }
+}
+
+bool BMS_Tasks_Register(Scheduler *sched,
+                        BMS_Pack *pack,
+                        const BMS_Task_Config *cfg,
+                        int task_ids[BMS_TASK_COUNT])
+{
+    if (sched == NULL || pack == NULL || cfg == NULL) return false;
+    if (pack->bms == NULL || pack->ekf == NULL || pack->soh == NULL ||
+        pack->fsm == NULL || pack->acc == NULL) return false;
+    if (pack->current_A == NULL || pack->voltage_V == NULL || pack->temp_C == NULL) return false;
+
+    /* Safety must see every sample */
+    if (cfg->period_ticks[BMS_TASK_SAFETY] != 1u) return false;
+
+    for (uint32_t c = 0; c < pack->n_cells; c++) {
+        BMS_Cell_Acc *acc = &pack->acc[c];
+        acc->ecm_As = 0.0f;
+        acc->ekf_As = 0.0f;
+        acc->soh_As = 0.0f;
+        acc->v_prev = VOLTAGE_MAX;   /* no end of discharge on the first tick */
+        acc->cycle_end = false;
+        acc->cycle_As = 0.0f;
+        acc->cycle_I = 0.0f;
+        acc->cycle_v = 0.0f;
+        acc->cycle_v_prev = 0.0f;
+    }
+    pack->sched = sched;
+    pack->soh_task = -1;
+
+    static const char *const names[BMS_TASK_COUNT] = { "SAFETY", "EKF", "ECM", "SOH" };
+    static const Sched_TaskFn fns[BMS_TASK_COUNT] = { task_safety, task_ekf, task_ecm, task_soh };
+
+    for (int i = 0; i < BMS_TASK_COUNT; i++) {
+        const uint16_t period = cfg->period_ticks[i];
+
+        /* Spread slow SOH work away from the EKF release tick */
+        const uint16_t offset = (i == BMS_TASK_SOH && period > 1u) ? (uint16_t)(period / 2u) : 0u;
+
+        const int id = Sched_AddTask(sched, names[i], fns[i], pack,
+                                     period, offset,
+                                     (uint8_t)i,              /* priority = enum order */
+                                     cfg->budget_us[i],
+                                     (i == BMS_TASK_SAFETY));
+        if (id < 0) return false;
+        if (task_ids != NULL) task_ids[i] = id;
+        if (i == BMS_TASK_SOH) pack->soh_task = id;
+    }
+
+    return true;
+}
@@ -4,6 +4,21 @@
 
 static float absf(float x) { return (x < 0.0f) ? -x : x; }
 
+/* Set / clear hold times per channel, bit order of Fault_Flag_t */
+typedef struct {
+    uint32_t set_ms;
+    uint32_t clr_ms;
+} Debounce_Cfg;
+
+static const Debounce_Cfg debounce_cfg[SAFETY_NUM_CHANNELS] = {
+    { SAFETY_SET_MS_VOLTAGE, SAFETY_CLR_MS_VOLTAGE },   /* OVERVOLTAGE  */
+    { SAFETY_SET_MS_VOLTAGE, SAFETY_CLR_MS_VOLTAGE },   /* UNDERVOLTAGE */
+    { SAFETY_SET_MS_CURRENT, SAFETY_CLR_MS_CURRENT },   /* OVERCURRENT  */
+    { SAFETY_SET_MS_TEMP,    SAFETY_CLR_MS_TEMP    },   /* OVERTEMP     */
+    { SAFETY_SET_MS_TEMP,    SAFETY_CLR_MS_TEMP    },   /* UNDERTEMP    */
+    { SAFETY_SET_MS_SOC,     SAFETY_CLR_MS_SOC     },   /* SOC_LOW      */
+};
+
 void Safety_Init(Safety_FSM *fsm)
 {
     if (!fsm) return;
@@ -19,6 +34,12 @@ void Safety_Init(Safety_FSM *fsm)
 
     fsm->state_entry_time = 0u;
     fsm->current_time = 0u;
+
+    for (uint8_t ch = 0; ch < SAFETY_NUM_CHANNELS; ch++) {
+        fsm->debounce_ms[ch] = 0u;
+    }
+    fsm->debounce_armed = 0u;
+    fsm->raw_flags = FAULT_NONE;
 }
 
 static void set_fault(Safety_FSM *fsm, uint8_t flag)
@@ -33,32 +54,80 @@ static void clear_fault(Safety_FSM *fsm, uint8_t flag)
     fsm->fault_flags &= (uint8_t)(~flag);
 }
 
-void Safety_Check(Safety_FSM *fsm,
-                  float voltage,
-                  float current,
-                  float temperature,
-                  float soc)
+/*
+  Debounce one channel. 'violated' is the raw limit check, 'recovered'
+  the hysteresis-adjusted clear check. The timer only runs while the
+  condition that would flip the flag holds, and restarts otherwise.
+  Each sample seeing the condition counts its own dt, the first one
+  included, so a hold shorter than the sample period flips on the first
+  sample. It accumulates elapsed ms rather than storing a start
+  timestamp, so a wrap of current_time does not affect it.
+*/
+static void debounce_channel(Safety_FSM *fsm,
+                             uint8_t ch,
+                             bool violated,
+                             bool recovered,
+                             uint32_t dt_ms)
 {
-    if (!fsm) return;
+    const uint8_t bit = (uint8_t)(1u << ch);
+    const bool active = (fsm->fault_flags & bit) != 0u;
+    const bool toward = active ? recovered : violated;
 
-    /* --- Fault detection --- */
-    if (voltage > VOLTAGE_MAX) set_fault(fsm, FAULT_OVERVOLTAGE);
-    else                        clear_fault(fsm, FAULT_OVERVOLTAGE);
+    if (violated) fsm->raw_flags |= bit;
 
-    if (voltage < VOLTAGE_MIN) set_fault(fsm, FAULT_UNDERVOLTAGE);
-    else                        clear_fault(fsm, FAULT_UNDERVOLTAGE);
+    if (!toward) {
+        fsm->debounce_armed &= (uint8_t)(~bit);
+        fsm->debounce_ms[ch] = 0u;
+        return;
+    }
+
+    if (!(fsm->debounce_armed & bit)) {
+        fsm->debounce_armed |= bit;
+        fsm->debounce_ms[ch] = 0u;
+    }
 
-    if (absf(current) > CURRENT_MAX) set_fault(fsm, FAULT_OVERCURRENT);
-    else                              clear_fault(fsm, FAULT_OVERCURRENT);
+    /* Saturating add */
+    const uint32_t t = fsm->debounce_ms[ch] + dt_ms;
+    fsm->debounce_ms[ch] = (t < fsm->debounce_ms[ch]) ? UINT32_MAX : t;
 
-    if (temperature > TEMP_MAX) set_fault(fsm, FAULT_OVERTEMP);
-    else                         clear_fault(fsm, FAULT_OVERTEMP);
+    const uint32_t hold = active ? debounce_cfg[ch].clr_ms : debounce_cfg[ch].set_ms;
+    if (fsm->debounce_ms[ch] >= hold) {
+        if (active) clear_fault(fsm, bit);
+        else        set_fault(fsm, bit);
+        fsm->debounce_armed &= (uint8_t)(~bit);
+        fsm->debounce_ms[ch] = 0u;
+    }
+}
 
-    if (temperature < TEMP_MIN) set_fault(fsm, FAULT_UNDERTEMP);
-    else                         clear_fault(fsm, FAULT_UNDERTEMP);
+void Safety_Check(Safety_FSM *fsm,
+                  float voltage,
+                  float current,
+                  float temperature,
+                  float soc,
+                  float dt_s)
+{
+    if (!fsm) return;
 
-    if (soc <= SOC_MIN + 1e-6f) set_fault(fsm, FAULT_SOC_LOW);
-    else                         clear_fault(fsm, FAULT_SOC_LOW);
+    /* --- Advance time --- */
+    const uint32_t dt_ms = (dt_s > 0.0f) ? (uint32_t)(dt_s * 1000.0f + 0.5f) : 0u;
+    fsm->current_time += dt_ms;
+
+    /* --- Fault detection (debounced, with hysteresis) --- */
+    const float i_abs = absf(current);
+    fsm->raw_flags = FAULT_NONE;
+
+    debounce_channel(fsm, 0u, voltage > VOLTAGE_MAX,
+                     voltage < VOLTAGE_MAX - SAFETY_HYST_VOLTAGE, dt_ms);
+    debounce_channel(fsm, 1u, voltage < VOLTAGE_MIN,
+                     voltage > VOLTAGE_MIN + SAFETY_HYST_VOLTAGE, dt_ms);
+    debounce_channel(fsm, 2u, i_abs > CURRENT_MAX,
+                     i_abs < CURRENT_MAX - SAFETY_HYST_CURRENT, dt_ms);
+    debounce_channel(fsm, 3u, temperature > TEMP_MAX,
+                     temperature < TEMP_MAX - SAFETY_HYST_TEMP, dt_ms);
+    debounce_channel(fsm, 4u, temperature < TEMP_MIN,
+                     temperature > TEMP_MIN + SAFETY_HYST_TEMP, dt_ms);
+    debounce_channel(fsm, 5u, soc <= SOC_MIN + 1e-6f,
+                     soc > SOC_MIN + SAFETY_HYST_SOC, dt_ms);
 
     /* --- State transitions --- */
     switch (fsm->current_state)
@@ -123,6 +192,12 @@ BMS_State_t Safety_GetState(const Safety_FSM *fsm)
     return fsm->current_state;
 }
 
+uint32_t Safety_TimeInState(const Safety_FSM *fsm)
+{
+    if (!fsm) return 0u;
+    return fsm->current_time - fsm->state_entry_time;   /* modulo 2^32 */
+}
+
 bool Safety_IsOperationAllowed(const Safety_FSM *fsm)
 {
     if (!fsm) return false;
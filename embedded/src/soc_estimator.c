@@ -1,6 +1,7 @@
 #include "soc_estimator.h"
 #include "bms_config.h"
 #include <math.h>
+#include <stddef.h>
 
 static float clampf(float x, float lo, float hi)
 {
@@ -76,6 +77,39 @@ void EKF_Predict(EKF_State *ekf, float current, float dt)
     ekf->p22 = AP10*A10 + AP11*A11 + ekf->q22;
 }
 
+void EKF_FastForward(EKF_State *ekf, float current, float dt_total, uint32_t n_steps)
+{
+    if (ekf == NULL || dt_total <= 0.0f || n_steps == 0u) return;
+
+    const float i_eff = fabsf(current);
+    const float tau = R1 * C1;
+
+    /* alpha_n = alpha^n over the whole interval, a2 = alpha^2 per step */
+    float alpha_n = 0.0f;
+    float a2 = 0.0f;
+    if (tau > 1e-9f) {
+        alpha_n = expf(-dt_total / tau);
+        a2 = expf(-2.0f * dt_total / ((float)n_steps * tau));
+    }
+
+    const float denom = (NOMINAL_CAPACITY * 3600.0f);
+    if (denom > 1e-12f) {
+        ekf->soc += (current * dt_total) / denom;
+        ekf->soc = clampf(ekf->soc, SOC_MIN, SOC_MAX);
+    }
+
+    ekf->v1 = ekf->v1 * alpha_n + (i_eff * R1) * (1.0f - alpha_n);
+
+    /* P_n = A^n P A'^n + sum_j A^j Q A'^j, A = diag(1, alpha) */
+    const float a2n = alpha_n * alpha_n;
+    const float q22_sum = (a2 < 1.0f - 1e-7f) ? (1.0f - a2n) / (1.0f - a2) : (float)n_steps;
+
+    ekf->p11 += (float)n_steps * ekf->q11;
+    ekf->p12 *= alpha_n;
+    ekf->p21 *= alpha_n;
+    ekf->p22 = a2n * ekf->p22 + q22_sum * ekf->q22;
+}
+
 void EKF_Update(EKF_State *ekf, float v_measured, float current)
 {
     if (ekf == NULL) return;
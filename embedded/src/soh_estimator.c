@@ -47,6 +47,32 @@ void SOH_Update(SOH_State *soh, float current_A, float voltage_V, float dt_s) {
     soh->prev_voltage = voltage_V;
 }
 
+void SOH_UpdateWindow(SOH_State *soh, float discharged_As, float current_A,
+                      float voltage_V, float prev_voltage_V) {
+    if (soh == NULL) return;
+    
+    if (voltage_V < soh->v_min_cycle) soh->v_min_cycle = voltage_V;
+    if (voltage_V > soh->v_max_cycle) soh->v_max_cycle = voltage_V;
+    
+    bool was_charging = soh->is_charging;
+    soh->is_charging = (current_A > 0.05f);
+    
+    if (discharged_As > 0.0f) {
+        soh->discharged_Ah += discharged_As / 3600.0f;
+    }
+    
+    if (was_charging && !soh->is_charging) {
+        soh->v_min_cycle = voltage_V;
+        soh->v_max_cycle = voltage_V;
+    }
+    
+    /* Same end-of-discharge test as per-sample updates */
+    soh->prev_voltage = prev_voltage_V;
+    SOH_CheckCycleComplete(soh, voltage_V);
+    
+    soh->prev_voltage = voltage_V;
+}
+
 bool SOH_CheckCycleComplete(SOH_State *soh, float voltage) {
     if (soh == NULL) return false;
     
@@ -0,0 +1,148 @@
+
+/*
+ * test_batch.c - Batch ABI must match the scalar per-call pipeline
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "bms_config.h"
+#include "bms_model.h"
+#include "safety_fsm.h"
+#include "soc_estimator.h"
+#include "soh_estimator.h"
+#include "bms_batch.h"
+#include "test_vectors.h"
+
+#define N_CELLS 4
+
+static double in_t[N_CELLS * NUM_TEST_SAMPLES];
+static float in_i[N_CELLS * NUM_TEST_SAMPLES];
+static float in_v[N_CELLS * NUM_TEST_SAMPLES];
+static float in_T[N_CELLS * NUM_TEST_SAMPLES];
+
+static float   out_soc[N_CELLS * NUM_TEST_SAMPLES];
+static float   out_v1[N_CELLS * NUM_TEST_SAMPLES];
+static float   out_vpred[N_CELLS * NUM_TEST_SAMPLES];
+static float   out_innov[N_CELLS * NUM_TEST_SAMPLES];
+static uint8_t out_fault[N_CELLS * NUM_TEST_SAMPLES];
+
+static uint64_t state_mem[4096];
+
+int main()
+{
+    printf("========================================\n");
+    printf("BMS BATCH ABI TEST (%d cells)\n", N_CELLS);
+    printf("========================================\n");
+
+    const int n = NUM_TEST_SAMPLES;
+
+    /* Each cell gets the vectors with a small per-cell current scale */
+    for (int c = 0; c < N_CELLS; c++) {
+        for (int k = 0; k < n; k++) {
+            in_t[c*n + k] = test_time[k];
+            in_i[c*n + k] = test_current[k] * (1.0f - 0.05f * (float)c);
+            in_v[c*n + k] = test_v_meas[k];
+            in_T[c*n + k] = 25.0f;
+        }
+    }
+
+    if (BMS_Batch_StateSize(N_CELLS) > sizeof(state_mem)) {
+        printf("❌ TEST FAILED - state buffer too small\n");
+        return 1;
+    }
+
+    BMS_Batch *batch = BMS_Batch_Init(state_mem, sizeof(state_mem), N_CELLS, 1.0f);
+    if (batch == NULL || BMS_Batch_NumCells(batch) != N_CELLS) {
+        printf("❌ TEST FAILED - init\n");
+        return 1;
+    }
+
+    BMS_Batch_Input in = { in_t, in_i, in_v, in_T, NULL };
+    BMS_Batch_Output out = { out_soc, out_v1, out_vpred, out_innov, out_fault };
+
+    /* Two half-length calls must be identical to one full call */
+    const int half = n / 2;
+    BMS_Batch_Input in2 = { in_t + half, in_i + half, in_v + half, in_T + half, NULL };
+    BMS_Batch_Output out2 = { out_soc + half, out_v1 + half, out_vpred + half,
+                              out_innov + half, out_fault + half };
+    BMS_Batch_Run(batch, &in, &out, (size_t)half, (size_t)n);
+    BMS_Batch_Run(batch, &in2, &out2, (size_t)(n - half), (size_t)n);
+
+    int mismatches = 0;
+
+    for (int c = 0; c < N_CELLS; c++) {
+        BMS_State bms;
+        EKF_State ekf;
+        SOH_State soh;
+        Safety_FSM fsm;
+
+        BMS_Init(&bms);
+        EKF_Init(&ekf, 1.0f);
+        SOH_Init(&soh, NOMINAL_CAPACITY);
+        Safety_Init(&fsm);
+
+        double t_prev = in_t[c*n];
+        for (int k = 0; k < n; k++) {
+            const int idx = c*n + k;
+            float dt = (float)(in_t[idx] - t_prev);
+            t_prev = in_t[idx];
+
+            BMS_ECM_Step(&bms, in_i[idx], dt);
+            EKF_Predict(&ekf, in_i[idx], dt);
+            EKF_Update(&ekf, in_v[idx], in_i[idx]);
+            SOH_Update(&soh, in_i[idx], in_v[idx], dt);
+            Safety_Check(&fsm, in_v[idx], in_i[idx], in_T[idx], ekf.soc, dt);
+
+            if (out_soc[idx] != ekf.soc || out_v1[idx] != ekf.v1 ||
+                out_vpred[idx] != ekf.last_v_pred ||
+                out_innov[idx] != ekf.last_innov ||
+                out_fault[idx] != fsm.fault_flags) {
+                mismatches++;
+            }
+        }
+
+        if (BMS_Batch_GetSafetyState(batch, (uint32_t)c) != (int)Safety_GetState(&fsm)) {
+            mismatches++;
+        }
+
+        printf("Cell %d: SOC %.4f  SOH %.1f%%  faults %s\n",
+               c, out_soc[c*n + n - 1], BMS_Batch_GetSOH(batch, (uint32_t)c),
+               Safety_GetFaultString(out_fault[c*n + n - 1]));
+    }
+
+    /*
+      Absolute timestamps: the same samples at Unix-epoch time must give
+      the same results (first sample seeds the clock, dt stays exact)
+    */
+    for (int c = 0; c < N_CELLS; c++) {
+        for (int k = 0; k < n; k++) in_t[c*n + k] = 1.7e9 + (double)test_time[k];
+    }
+    static float epoch_soc[N_CELLS * NUM_TEST_SAMPLES];
+    BMS_Batch_Output out3 = { epoch_soc, NULL, NULL, NULL, NULL };
+    batch = BMS_Batch_Init(state_mem, sizeof(state_mem), N_CELLS, 1.0f);
+    BMS_Batch_Run(batch, &in, &out3, (size_t)n, (size_t)n);
+    int epoch_diff = 0;
+    for (int i = 0; i < N_CELLS * n; i++) {
+        if (epoch_soc[i] != out_soc[i]) epoch_diff++;
+    }
+    printf("Epoch timestamps: %d SOC differences\n", epoch_diff);
+    mismatches += epoch_diff;
+
+    /* Argument checks */
+    if (BMS_Batch_Init(state_mem, 8, N_CELLS, 1.0f) != NULL) mismatches++;
+    if (BMS_Batch_Run(batch, NULL, &out, (size_t)n, (size_t)n) != 0) mismatches++;
+    if (BMS_Batch_Run(batch, &in, &out, (size_t)n, (size_t)(n - 1)) != 0) mismatches++;
+
+    printf("\nMismatches vs scalar pipeline: %d\n", mismatches);
+
+    if (mismatches == 0) {
+        printf("\n✅ TEST PASSED - batch ABI matches scalar calls\n");
+        return 0;
+    } else {
+        printf("\n❌ TEST FAILED - batch ABI differs from scalar calls\n");
+        return 1;
+    }
+}
@@ -0,0 +1,22 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+/*
+ * test_check.h - Shared pass/fail bookkeeping for the unit tests
+ *
+ * Each test program includes this once; check() prints one line per
+ * assertion and main() reports PASSED/FAILED from 'failures'.
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+
+static int failures = 0;
+
+static void check(bool ok, const char *what)
+{
+    printf("%s %s\n", ok ? "  ok  " : "  FAIL", what);
+    if (!ok) failures++;
+}
+
+#endif
@@ -0,0 +1,347 @@
+
+/*
+ * test_fault_injection.c - Fault-injection harness for the debounced safety FSM
+ *
+ * Replays step and ramp limit violations (with sensor noise) for every
+ * fault channel and reports detection latency, recovery time and false-trip
+ * rate at a fast sampling period and at the deployed DT_CORE. Fails if a
+ * step violation is missed or detected later than the analytical bound
+ * (set time rounded up to whole samples, i.e. max(set time, dt) for the
+ * configured set times), if the noise-alone trip rate strays from what
+ * independent samples predict (none at the fast period), or if
+ * detection changes across a current_time wrap.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "bms_config.h"
+#include "safety_fsm.h"
+
+#define HARNESS_DT_S     (0.01f)      /* fast safety sampling period */
+#define N_TRIALS         (200)
+#define PRE_S            (2.0f)       /* nominal lead-in */
+#define HOLD_S           (10.0f)      /* violation held this long */
+#define POST_S           (12.0f)      /* nominal tail for recovery */
+#define RAMP_S           (5.0f)       /* ramp duration nominal -> peak */
+#define FALSE_TRIP_S     (3600.0f)    /* nominal run for false-trip rate */
+
+typedef enum { SIG_VOLTAGE = 0, SIG_CURRENT, SIG_TEMP, SIG_SOC } Signal_t;
+
+typedef struct {
+    const char *name;
+    uint8_t  flag;
+    Signal_t signal;
+    float    nominal;
+    float    limit;
+    float    dir;          /* +1 = over-limit fault, -1 = under-limit fault */
+    float    sigma;        /* sensor noise (1 sigma) */
+    float    delta;        /* peak excursion beyond the limit */
+    uint32_t set_ms;
+    uint32_t clr_ms;
+} Channel;
+
+static const Channel channels[] = {
+    { "OVERVOLTAGE",  FAULT_OVERVOLTAGE,  SIG_VOLTAGE, 4.00f, VOLTAGE_MAX,  1.0f, 0.010f, 0.10f,
+      SAFETY_SET_MS_VOLTAGE, SAFETY_CLR_MS_VOLTAGE },
+    { "UNDERVOLTAGE", FAULT_UNDERVOLTAGE, SIG_VOLTAGE, 3.00f, VOLTAGE_MIN, -1.0f, 0.010f, 0.10f,
+      SAFETY_SET_MS_VOLTAGE, SAFETY_CLR_MS_VOLTAGE },
+    { "OVERCURRENT",  FAULT_OVERCURRENT,  SIG_CURRENT, 1.00f, CURRENT_MAX,  1.0f, 0.020f, 0.50f,
+      SAFETY_SET_MS_CURRENT, SAFETY_CLR_MS_CURRENT },
+    { "OVERTEMP",     FAULT_OVERTEMP,     SIG_TEMP,   30.0f,  TEMP_MAX,     1.0f, 0.300f, 5.00f,
+      SAFETY_SET_MS_TEMP, SAFETY_CLR_MS_TEMP },
+    { "UNDERTEMP",    FAULT_UNDERTEMP,    SIG_TEMP,    0.0f,  TEMP_MIN,    -1.0f, 0.300f, 5.00f,
+      SAFETY_SET_MS_TEMP, SAFETY_CLR_MS_TEMP },
+    { "SOC_LOW",      FAULT_SOC_LOW,      SIG_SOC,     0.20f, SOC_MIN,     -1.0f, 0.002f, 0.02f,
+      SAFETY_SET_MS_SOC, SAFETY_CLR_MS_SOC },
+};
+
+#define N_CHANNELS ((int)(sizeof(channels) / sizeof(channels[0])))
+
+typedef enum { PROFILE_STEP = 0, PROFILE_RAMP } Profile_t;
+
+/* Deterministic PRNG (xorshift32) + Box-Muller */
+static uint32_t rng_state = 0x12345678u;
+
+static float rng_uniform(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return ((float)(rng_state >> 8) + 0.5f) / 16777216.0f;
+}
+
+static float rng_gauss(void)
+{
+    const float u1 = rng_uniform();
+    const float u2 = rng_uniform();
+    return sqrtf(-2.0f * logf(u1)) * cosf(6.2831853f * u2);
+}
+
+/* Noise-free signal for a profile; t_on = start of violation phase */
+static float profile_value(const Channel *ch, Profile_t p, float t, float t_on)
+{
+    const float peak = ch->limit + ch->dir * ch->delta;
+    const float t_off = t_on + HOLD_S;
+
+    if (p == PROFILE_STEP) {
+        return (t >= t_on && t < t_off) ? peak : ch->nominal;
+    }
+
+    /* Ramp up over RAMP_S from t_on, hold, ramp down over RAMP_S from t_off */
+    if (t < t_on) return ch->nominal;
+    if (t < t_on + RAMP_S) return ch->nominal + (peak - ch->nominal) * (t - t_on) / RAMP_S;
+    if (t < t_off) return peak;
+    if (t < t_off + RAMP_S) return peak + (ch->nominal - peak) * (t - t_off) / RAMP_S;
+    return ch->nominal;
+}
+
+/* When the noise-free signal crosses the limit going out / coming back */
+static void profile_crossings(const Channel *ch, Profile_t p, float t_on,
+                              float *t_out, float *t_back)
+{
+    if (p == PROFILE_STEP) {
+        *t_out = t_on;
+        *t_back = t_on + HOLD_S;
+        return;
+    }
+
+    const float frac = fabsf(ch->limit - ch->nominal) / fabsf(ch->limit + ch->dir * ch->delta - ch->nominal);
+    *t_out = t_on + RAMP_S * frac;
+    *t_back = t_on + HOLD_S + RAMP_S * (1.0f - frac);
+}
+
+static void feed(Safety_FSM *fsm, const Channel *ch, float value, float dt)
+{
+    float v = 3.7f, i = 1.0f, temp = 25.0f, soc = 0.5f;
+
+    switch (ch->signal) {
+        case SIG_VOLTAGE: v = value;    break;
+        case SIG_CURRENT: i = value;    break;
+        case SIG_TEMP:    temp = value; break;
+        case SIG_SOC:     soc = value;  break;
+    }
+
+    Safety_Check(fsm, v, i, temp, soc, dt);
+}
+
+typedef struct {
+    float lat_worst_ms, lat_sum_ms;
+    float rec_worst_ms, rec_sum_ms;
+    int   detected, recovered, trials;
+} Injection_Result;
+
+static Injection_Result run_injection(const Channel *ch, Profile_t p, float dt)
+{
+    Injection_Result r = { 0.0f, 0.0f, 0.0f, 0.0f, 0, 0, 0 };
+
+    for (int trial = 0; trial < N_TRIALS; trial++) {
+        Safety_FSM fsm;
+        Safety_Init(&fsm);
+
+        /* Violation onset at a random phase within a sample period */
+        const float t_on = PRE_S + dt * rng_uniform();
+        float t_out, t_back;
+        profile_crossings(ch, p, t_on, &t_out, &t_back);
+
+        const int n = (int)((PRE_S + HOLD_S + 2.0f * RAMP_S + POST_S) / dt);
+        float t_set = -1.0f, t_clear = -1.0f;
+
+        for (int k = 0; k < n; k++) {
+            const float t = (float)k * dt;
+            const float value = profile_value(ch, p, t, t_on) + ch->sigma * rng_gauss();
+
+            feed(&fsm, ch, value, (k == 0) ? 0.0f : dt);
+
+            const bool active = (fsm.fault_flags & ch->flag) != 0u;
+            if (active && t_set < 0.0f) t_set = t;
+            if (!active && t_set >= 0.0f && t_clear < 0.0f && t >= t_back) t_clear = t;
+        }
+
+        r.trials++;
+        if (t_set >= 0.0f) {
+            const float lat = (t_set - t_out) * 1000.0f;
+            r.detected++;
+            r.lat_sum_ms += lat;
+            if (lat > r.lat_worst_ms) r.lat_worst_ms = lat;
+        }
+        if (t_clear >= 0.0f && Safety_IsOperationAllowed(&fsm)) {
+            const float rec = (t_clear - t_back) * 1000.0f;
+            r.recovered++;
+            r.rec_sum_ms += rec;
+            if (rec > r.rec_worst_ms) r.rec_worst_ms = rec;
+        }
+    }
+
+    return r;
+}
+
+/* Samples a violation must span to set: each one counts its own dt */
+static uint32_t samples_to_set(const Channel *ch, float dt)
+{
+    const uint32_t dt_ms = (uint32_t)(dt * 1000.0f + 0.5f);
+    const uint32_t n = (ch->set_ms + dt_ms - 1u) / dt_ms;
+    return (n > 0u) ? n : 1u;
+}
+
+/*
+  Hold the signal 2 sigma inside the limit and count trips per hour.
+  The signal never reaches the clear hysteresis, so a trip would latch:
+  the FSM is re-initialised after each one to keep counting, so a run
+  of violating samples trips once per samples_to_set() samples.
+  expected_per_h is that rate if noise samples were independent, from
+  the observed fraction of violating samples.
+*/
+static void run_false_trips(const Channel *ch, float dt, float *raw_per_h,
+                            float *trips_per_h, float *expected_per_h)
+{
+    Safety_FSM fsm;
+    Safety_Init(&fsm);
+
+    const float value = ch->limit - ch->dir * 2.0f * ch->sigma;
+    const int n = (int)(FALSE_TRIP_S / dt);
+
+    int raw = 0, trips = 0, raw_samples = 0;
+    bool raw_prev = false, flag_prev = false;
+
+    for (int k = 0; k < n; k++) {
+        feed(&fsm, ch, value + ch->sigma * rng_gauss(), dt);
+
+        const bool raw_now = (fsm.raw_flags & ch->flag) != 0u;
+        const bool flag_now = (fsm.fault_flags & ch->flag) != 0u;
+        if (raw_now) raw_samples++;
+        if (raw_now && !raw_prev) raw++;
+        if (flag_now && !flag_prev) trips++;
+        raw_prev = raw_now;
+        flag_prev = flag_now;
+
+        if (flag_now) {
+            Safety_Init(&fsm);
+            flag_prev = false;
+        }
+    }
+
+    *raw_per_h = (float)raw * 3600.0f / FALSE_TRIP_S;
+    *trips_per_h = (float)trips * 3600.0f / FALSE_TRIP_S;
+
+    const double p = (double)raw_samples / (double)n;
+    const double pn = pow(p, (double)samples_to_set(ch, dt));
+    *expected_per_h = (float)(3600.0 / dt * (1.0 - p) * pn / (1.0 - pn));
+}
+
+/*
+  Worst-case step latency: the first violating sample lands up to one
+  period after onset and already counts a full period, so detection
+  takes at most samples_to_set() periods, max(set_ms, dt) whenever the
+  set time is below or a multiple of the period.
+*/
+static float latency_bound_ms(const Channel *ch, float dt)
+{
+    const uint32_t dt_ms = (uint32_t)(dt * 1000.0f + 0.5f);
+    return (float)(samples_to_set(ch, dt) * dt_ms) + 0.5f;
+}
+
+/* Injection and false-trip tables at one sampling period; returns failures */
+static int run_harness(float dt)
+{
+    int failures = 0;
+
+    printf("\nSample period %.0f ms, %d trials per profile, noise on\n",
+           dt * 1000.0f, N_TRIALS);
+    printf("\nFault\t\tProfile\tSet/Clr(ms)\tLat avg/worst(ms)\tBound(ms)\tRec avg/worst(ms)\tDetected\n");
+    printf("----------------------------------------------------------------------------------------------------------\n");
+
+    const uint32_t dt_ms = (uint32_t)(dt * 1000.0f + 0.5f);
+
+    for (int c = 0; c < N_CHANNELS; c++) {
+        const Channel *ch = &channels[c];
+        const float bound_ms = latency_bound_ms(ch, dt);
+        const float max_set_dt_ms = (float)((ch->set_ms > dt_ms) ? ch->set_ms : dt_ms) + 0.5f;
+
+        for (int p = PROFILE_STEP; p <= PROFILE_RAMP; p++) {
+            const Injection_Result r = run_injection(ch, (Profile_t)p, dt);
+            const float lat_avg = (r.detected > 0) ? r.lat_sum_ms / (float)r.detected : 0.0f;
+            const float rec_avg = (r.recovered > 0) ? r.rec_sum_ms / (float)r.recovered : 0.0f;
+
+            printf("%-12s\t%s\t%u/%u\t\t%.0f / %.0f\t\t%.0f\t\t%.0f / %.0f\t\t%d/%d\n",
+                   ch->name, (p == PROFILE_STEP) ? "step" : "ramp",
+                   ch->set_ms, ch->clr_ms,
+                   lat_avg, r.lat_worst_ms, bound_ms, rec_avg, r.rec_worst_ms,
+                   r.detected, r.trials);
+
+            if (r.detected != r.trials || r.recovered != r.trials) failures++;
+            if (p == PROFILE_STEP && r.lat_worst_ms > bound_ms) failures++;
+            if (p == PROFILE_STEP && r.lat_worst_ms > max_set_dt_ms) failures++;
+        }
+    }
+
+    /*
+      Trips must stay within a factor of two of the independent-noise
+      rate: zero when the set time spans many samples, but at DT_CORE
+      no set time is longer than one sample, so a single violating
+      sample trips. Where tens of trips are expected the lower side is
+      checked too, so an undercounting harness fails.
+    */
+    printf("\nFault\t\tSamples to set\tRaw onsets/h\tDebounced trips/h\tExpected/h (signal 2 sigma inside limit)\n");
+    printf("----------------------------------------------------------------------------------------------\n");
+
+    for (int c = 0; c < N_CHANNELS; c++) {
+        float raw_h, trips_h, expected_h;
+        run_false_trips(&channels[c], dt, &raw_h, &trips_h, &expected_h);
+        printf("%-12s\t%u\t\t%.0f\t\t%.1f\t\t\t%.2g\n", channels[c].name,
+               samples_to_set(&channels[c], dt), raw_h, trips_h, expected_h);
+        if (trips_h > 2.0f * expected_h) failures++;
+        if (expected_h >= 10.0f && trips_h < 0.5f * expected_h) failures++;
+    }
+
+    return failures;
+}
+
+/* Same overvoltage step with current_time just below and at zero */
+static bool wrap_unaffected(void)
+{
+    uint32_t set_at[2];
+
+    for (int w = 0; w < 2; w++) {
+        Safety_FSM fsm;
+        Safety_Init(&fsm);
+        const uint32_t start = (w == 0) ? 0u : UINT32_MAX - 100u;
+        fsm.current_time = start;
+        fsm.state_entry_time = start;
+
+        set_at[w] = 0u;
+        for (int k = 0; k < 100 && set_at[w] == 0u; k++) {
+            feed(&fsm, &channels[0], (k < 5) ? 4.0f : VOLTAGE_MAX + 0.1f, HARNESS_DT_S);
+            if (fsm.fault_flags & FAULT_OVERVOLTAGE) set_at[w] = fsm.current_time - start;
+        }
+        /* Entered FAULT on the setting sample */
+        for (int k = 0; k < 3; k++) feed(&fsm, &channels[0], VOLTAGE_MAX + 0.1f, HARNESS_DT_S);
+        if (Safety_TimeInState(&fsm) != 30u) return false;
+    }
+
+    printf("\ncurrent_time wrap: overvoltage set after %u ms from 0, %u ms across wrap\n",
+           set_at[0], set_at[1]);
+    return set_at[0] != 0u && set_at[0] == set_at[1];
+}
+
+int main()
+{
+    printf("========================================\n");
+    printf("SAFETY FAULT-INJECTION HARNESS\n");
+    printf("========================================\n");
+
+    int failures = 0;
+    failures += run_harness(HARNESS_DT_S);
+    failures += run_harness(DT_CORE);
+    if (!wrap_unaffected()) failures++;
+
+    if (failures == 0) {
+        printf("\n✅ TEST PASSED - faults detected within bound, false trips as predicted\n");
+        return 0;
+    } else {
+        printf("\n❌ TEST FAILED - %d check(s) failed\n", failures);
+        return 1;
+    }
+}
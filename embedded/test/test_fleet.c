@@ -0,0 +1,142 @@
+
+/*
+ * test_fleet.c - Packed fleet store: round trip, stepping accuracy, cold writes
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include "bms_config.h"
+#include "bms_fleet.h"
+#include "test_vectors.h"
+#include "test_check.h"
+
+#define N_CELLS 8
+
+static uint64_t store_mem[1024];
+
+int main()
+{
+    printf("========================================\n");
+    printf("FLEET STATE STORE TEST\n");
+    printf("========================================\n");
+    printf("Working structs: %u bytes/cell, packed: %u bytes/cell\n",
+           (unsigned)sizeof(Fleet_Cell), (unsigned)Fleet_BytesPerCell());
+
+    check(Fleet_StoreSize(N_CELLS) <= sizeof(store_mem), "store fits test buffer");
+    check(Fleet_BytesPerCell() * 2u <= sizeof(Fleet_Cell), "packed at most half of working size");
+
+    Fleet_Store *store = Fleet_Create(store_mem, sizeof(store_mem), N_CELLS, 1.0f);
+    check(store != NULL && Fleet_NumCells(store) == N_CELLS, "create");
+    check(Fleet_Create(store_mem, 16u, N_CELLS, 1.0f) == NULL, "undersized buffer rejected");
+
+    /* Fresh cell expands to the same state as the init functions */
+    {
+        Fleet_Cell ref, work;
+        BMS_Init(&ref.bms);
+        EKF_Init(&ref.ekf, 1.0f);
+        SOH_Init(&ref.soh, NOMINAL_CAPACITY);
+        Safety_Init(&ref.fsm);
+
+        store = Fleet_Create(store_mem, sizeof(store_mem), N_CELLS, 1.0f);
+        Fleet_Expand(store, 3u, &work);
+
+        check(work.ekf.soc == ref.ekf.soc && work.bms.soc == ref.bms.soc, "SOC exact");
+        check(fabsf(work.ekf.p11 - ref.ekf.p11) < 1e-5f && work.ekf.p12 == work.ekf.p21,
+              "covariance restored symmetric");
+        check(work.ekf.q11 == ref.ekf.q11 && work.ekf.r_voltage == ref.ekf.r_voltage,
+              "fleet-wide noise restored");
+        check(fabsf(work.soh.capacity_est_Ah - ref.soh.capacity_est_Ah) < 1e-3f &&
+              work.soh.soh_percent == 100.0f, "capacity within fp16");
+        check(work.fsm.current_state == ref.fsm.current_state &&
+              work.fsm.current_limit == ref.fsm.current_limit, "safety state restored");
+    }
+
+    /* Packed stepping tracks the full-precision pipeline */
+    {
+        Fleet_Cell ref[N_CELLS];
+        for (int c = 0; c < N_CELLS; c++) {
+            BMS_Init(&ref[c].bms);
+            EKF_Init(&ref[c].ekf, 1.0f);
+            SOH_Init(&ref[c].soh, NOMINAL_CAPACITY);
+            Safety_Init(&ref[c].fsm);
+        }
+
+        float I[N_CELLS], V[N_CELLS], T[N_CELLS], soc[N_CELLS];
+        float max_soc_diff = 0.0f;
+        int flag_mismatch = 0;
+
+        for (int k = 1; k < NUM_TEST_SAMPLES; k++) {
+            const float dt = test_time[k] - test_time[k - 1];
+            for (int c = 0; c < N_CELLS; c++) {
+                I[c] = test_current[k] * (1.0f - 0.05f * (float)c);
+                V[c] = test_v_meas[k];
+                T[c] = 25.0f;
+
+                BMS_ECM_Step(&ref[c].bms, I[c], dt);
+                EKF_Predict(&ref[c].ekf, I[c], dt);
+                EKF_Update(&ref[c].ekf, V[c], I[c]);
+                SOH_Update(&ref[c].soh, I[c], V[c], dt);
+                Safety_Check(&ref[c].fsm, V[c], I[c], T[c], ref[c].ekf.soc, dt);
+            }
+
+            Fleet_Step(store, 0u, N_CELLS, I, V, T, dt, soc);
+
+            for (int c = 0; c < N_CELLS; c++) {
+                Fleet_Cell work;
+                Fleet_Expand(store, (uint32_t)c, &work);
+                const float d = fabsf(soc[c] - ref[c].ekf.soc);
+                if (d > max_soc_diff) max_soc_diff = d;
+                if (work.fsm.fault_flags != ref[c].fsm.fault_flags ||
+                    work.fsm.current_state != ref[c].fsm.current_state) flag_mismatch++;
+            }
+        }
+
+        printf("Max SOC difference packed vs full: %.2e\n", max_soc_diff);
+        check(max_soc_diff < 1e-3f, "packed SOC within 0.1% of full precision");
+        check(flag_mismatch == 0, "fault flags and states identical");
+    }
+
+    /* Cold records untouched by plain steps, rewritten on events */
+    {
+        static uint8_t cold_before[N_CELLS * 64];
+        float I[N_CELLS], V[N_CELLS], T[N_CELLS];
+        for (int c = 0; c < N_CELLS; c++) { I[c] = -1.0f; V[c] = 3.9f; T[c] = 25.0f; }
+
+        store = Fleet_Create(store_mem, sizeof(store_mem), N_CELLS, 1.0f);
+        Fleet_Step(store, 0u, N_CELLS, I, V, T, 1.0f, NULL);   /* IDLE -> DISCHARGING */
+
+        size_t cold_bytes = 0u;
+        const uint8_t *cold = Fleet_ColdRegion(store, &cold_bytes);
+        check(cold != NULL && cold_bytes <= sizeof(cold_before), "cold region");
+        memcpy(cold_before, cold, cold_bytes);
+
+        for (int k = 0; k < 50; k++) Fleet_Step(store, 0u, N_CELLS, I, V, T, 1.0f, NULL);
+        check(memcmp(cold_before, cold, cold_bytes) == 0, "cold bytes unchanged across plain steps");
+
+        for (int c = 0; c < N_CELLS; c++) V[c] = VOLTAGE_MAX + 0.1f;
+        Fleet_Step(store, 0u, N_CELLS, I, V, T, 1.0f, NULL);   /* overvoltage sets -> FAULT */
+        Fleet_Cell work;
+        Fleet_Expand(store, 0u, &work);
+        check(memcmp(cold_before, cold, cold_bytes) != 0 &&
+              work.fsm.current_state == BMS_STATE_FAULT && work.fsm.fault_start_time == 52000u,
+              "state change rewrites cold record");
+    }
+
+    /* Attach validates the header */
+    {
+        static uint64_t junk[16];
+        check(Fleet_Attach(junk, sizeof(junk)) == NULL, "attach rejects non-store");
+    }
+
+    if (failures == 0) {
+        printf("\n✅ TEST PASSED - fleet store round trips and tracks full precision\n");
+        return 0;
+    } else {
+        printf("\n❌ TEST FAILED - %d check(s) failed\n", failures);
+        return 1;
+    }
+}
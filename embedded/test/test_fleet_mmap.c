@@ -0,0 +1,55 @@
+/*
+ * test_fleet_mmap.c - Fleet store persistence through the POSIX mmap backend
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+#include "bms_fleet.h"
+#include "test_check.h"
+
+#define N_CELLS 8
+
+int main()
+{
+    printf("========================================\n");
+    printf("FLEET STORE MMAP TEST\n");
+    printf("========================================\n");
+
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/bms_fleet_test_%d.bin", (int)getpid());
+    unlink(path);
+
+    Fleet_Mapping map;
+    Fleet_Store *mapped = Fleet_MapFile(path, N_CELLS, 0.8f, &map);
+    check(mapped != NULL, "map creates file");
+
+    float I[N_CELLS], V[N_CELLS], T[N_CELLS], soc[N_CELLS];
+    for (int c = 0; c < N_CELLS; c++) { I[c] = -1.0f; V[c] = 3.9f; T[c] = 25.0f; }
+    for (int k = 0; k < 10; k++) Fleet_Step(mapped, 0u, N_CELLS, I, V, T, 1.0f, soc);
+
+    check(Fleet_Sync(&map), "sync");
+    Fleet_Unmap(&map);
+
+    check(Fleet_MapFile(path, N_CELLS + 1u, 0.8f, &map) == NULL, "cell count mismatch rejected");
+
+    mapped = Fleet_MapFile(path, 0u, 0.0f, &map);
+    Fleet_Cell work;
+    check(mapped != NULL && Fleet_Expand(mapped, N_CELLS - 1u, &work) &&
+          work.ekf.soc == soc[N_CELLS - 1] && work.bms.step_count == 10u,
+          "reopened store keeps state");
+    Fleet_Unmap(&map);
+    unlink(path);
+
+    if (failures == 0) {
+        printf("\n✅ TEST PASSED - mapped fleet store persists across reopen\n");
+        return 0;
+    } else {
+        printf("\n❌ TEST FAILED - %d check(s) failed\n", failures);
+        return 1;
+    }
+}
@@ -0,0 +1,154 @@
+
+/*
+ * test_forecast.c - Time-to-empty and state-of-power forecasts against
+ *                   step-by-step ECM simulation
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "bms_config.h"
+#include "bms_model.h"
+#include "bms_forecast.h"
+#include "test_check.h"
+
+#define N_SCEN   (100u)      /* not a multiple of FORECAST_LANES */
+#define N_STEPS  (600u)
+
+static float cur[N_STEPS * N_SCEN];
+static float tte[N_SCEN], vmin[N_SCEN], soc_end[N_SCEN];
+
+/* Reference: BMS_ECM_Step shares the EKF model */
+static void simulate(const EKF_State *ekf, uint32_t s, float dt,
+                     float *tte_lo, float *v_min, float *soc_out)
+{
+    BMS_State st;
+    BMS_Init(&st);
+    st.soc = ekf->soc;
+    st.v1 = ekf->v1;
+
+    *tte_lo = INFINITY;
+    *v_min = INFINITY;
+    for (uint32_t k = 0; k < N_STEPS; k++) {
+        const float I = cur[k * N_SCEN + s];
+        const float v_start = BMS_GetVoltage(&st, I);
+        BMS_ECM_Step(&st, I, dt);
+
+        const float vm = (v_start < st.v_terminal) ? v_start : st.v_terminal;
+        if (vm < *v_min) *v_min = vm;
+        if (st.v_terminal < VOLTAGE_MIN || st.soc <= SOC_MIN) {
+            *tte_lo = (float)k * dt;
+            break;
+        }
+    }
+    *soc_out = st.soc;
+}
+
+/* Min terminal voltage and final SOC at constant discharge for H seconds */
+static void hold(const EKF_State *ekf, float I, float H, float *v_min, float *soc)
+{
+    BMS_State st;
+    BMS_Init(&st);
+    st.soc = ekf->soc;
+    st.v1 = ekf->v1;
+
+    *v_min = BMS_GetVoltage(&st, -I);
+    const uint32_t n = (uint32_t)(H / 0.05f);
+    for (uint32_t k = 0; k < n; k++) {
+        BMS_ECM_Step(&st, -I, 0.05f);
+        if (st.v_terminal < *v_min) *v_min = st.v_terminal;
+    }
+    *soc = st.soc;
+}
+
+int main()
+{
+    printf("========================================\n");
+    printf("FORECAST TEST\n");
+    printf("========================================\n");
+
+    EKF_State ekf;
+    EKF_Init(&ekf, 0.05f);
+    ekf.v1 = 0.02f;
+
+    /* Discharge levels, pulsed loads and one charging scenario */
+    for (uint32_t s = 0; s < N_SCEN; s++) {
+        for (uint32_t k = 0; k < N_STEPS; k++) {
+            float I = -(0.2f + 1.8f * (float)s / (float)(N_SCEN - 1u));
+            if (s % 3u == 1u && (k / 20u) % 2u == 1u) I *= 0.25f;
+            if (s == N_SCEN - 1u) I = 1.0f;
+            cur[k * N_SCEN + s] = I;
+        }
+    }
+
+    BMS_Forecast_Scenarios sc = { cur, N_SCEN, N_STEPS, N_SCEN, DT_CORE };
+    BMS_Forecast_Output out = { tte, vmin, soc_end };
+    check(BMS_Forecast_Run(&ekf, &sc, &out) == N_SCEN, "all scenarios run");
+
+    bool tte_ok = true, vmin_ok = true, soc_ok = true;
+    uint32_t n_empty = 0u;
+    for (uint32_t s = 0; s < N_SCEN; s++) {
+        float lo, vm, soc;
+        simulate(&ekf, s, DT_CORE, &lo, &vm, &soc);
+
+        if (isinf(lo)) {
+            if (!isinf(tte[s])) tte_ok = false;
+            if (fabsf(soc_end[s] - soc) > 1e-5f) soc_ok = false;
+        } else {
+            n_empty++;
+            if (tte[s] < lo - 1e-3f || tte[s] > lo + DT_CORE + 1e-3f) tte_ok = false;
+        }
+        if (fabsf(vmin[s] - vm) > 1e-3f) vmin_ok = false;   /* SOC unclamped in the empty step */
+    }
+    printf("        %u of %u scenarios empty within %u s\n", n_empty, N_SCEN, N_STEPS);
+    check(n_empty > 0u && n_empty < N_SCEN, "mix of empty and surviving scenarios");
+    check(tte_ok, "time to empty inside the reference step");
+    check(vmin_ok, "minimum voltage matches reference");
+    check(soc_ok, "end SOC matches reference");
+
+    /* Constant-current scenario: empty exactly when the charge runs out */
+    const float expect = 0.05f * NOMINAL_CAPACITY * 3600.0f / -cur[N_SCEN - 2u];
+    check(fabsf(tte[N_SCEN - 2u] - expect) < 0.05f, "interpolated SOC crossing");
+
+    /* State of power: SOC-limited at low SOC */
+    BMS_SOP_Result sop[3];
+    EKF_Init(&ekf, 0.01f);
+    BMS_Forecast_SOPDefault(&ekf, sop);
+    bool sop_ok = true;
+    for (uint32_t h = 0; h < 3u; h++) {
+        float vm, soc;
+        hold(&ekf, sop[h].current_A, sop[h].horizon_s, &vm, &soc);
+        if (vm < VOLTAGE_MIN - 1e-3f || soc < SOC_MIN) sop_ok = false;
+        /* The binding limit is tight */
+        if (sop[h].limit == SOP_LIMIT_CURRENT && sop[h].current_A != CURRENT_MAX) sop_ok = false;
+        if (sop[h].limit == SOP_LIMIT_SOC) {
+            hold(&ekf, sop[h].current_A * 1.02f, sop[h].horizon_s, &vm, &soc);
+            if (soc > SOC_MIN + 1e-6f) sop_ok = false;
+        }
+    }
+    check(sop[0].limit == SOP_LIMIT_CURRENT && sop[2].limit == SOP_LIMIT_SOC &&
+          sop[2].current_A < sop[1].current_A, "SOP limited by current, then SOC at longer horizon");
+    check(sop_ok, "SOP current sustainable and its limit is tight");
+
+    /* Voltage-limited: large polarization at low SOC */
+    EKF_Init(&ekf, 0.05f);
+    ekf.v1 = 0.45f;
+    BMS_Forecast_SOPDefault(&ekf, sop);
+    float vm, soc;
+    hold(&ekf, sop[0].current_A, sop[0].horizon_s, &vm, &soc);
+    const bool at_limit = fabsf(vm - VOLTAGE_MIN) < 1e-3f;
+    hold(&ekf, sop[0].current_A * 1.02f, sop[0].horizon_s, &vm, &soc);
+    check(sop[0].limit == SOP_LIMIT_VOLTAGE && at_limit && vm < VOLTAGE_MIN,
+          "SOP voltage-limited at VOLTAGE_MIN");
+    check(fabsf(sop[0].power_W - sop[0].current_A * sop[0].v_min) < 1e-5f, "power = current x min voltage");
+
+    if (failures == 0) {
+        printf("\n✅ TEST PASSED - forecasts match step-by-step simulation\n");
+        return 0;
+    } else {
+        printf("\n❌ TEST FAILED - %d check(s) failed\n", failures);
+        return 1;
+    }
+}
@@ -0,0 +1,114 @@
+
+/*
+ * test_import.c - NASA CSV import: column detection, cleaning, resampling
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#include "bms_config.h"
+#include "bms_import.h"
+#include "test_check.h"
+
+static bool near(float a, float b)
+{
+    return fabsf(a - b) < 1e-5f;
+}
+
+/* NASA charge cycle: off-grid times, a NaN row and an empty field */
+static const char charge_csv[] =
+    "\"Voltage_measured\",\"Current_measured\",\"Temperature_measured\",\"Current_charge\",\"Voltage_charge\",\"Time\"\r\n"
+    "3.5,-1.0,24.0,1.0,4.2,0.5\r\n"
+    "3.7,-1.4,25.0,1.0,4.2,2.5\r\n"
+    "NaN,-1.4,25.0,1.0,4.2,3.0\r\n"
+    "3.9,-1.8,26.0,1.0,4.2,4.5\r\n"
+    "3.9,,26.0,1.0,4.2,5.0\r\n";
+
+/* Generic names, no temperature, one row out of order */
+static const char discharge_csv[] =
+    "time,voltage,current\n"
+    "10,4.0,2.0\n"
+    "12,3.8,2.0\n"
+    "11,3.9,2.0\n"
+    "13,3.7,2.0\n";
+
+int main()
+{
+    printf("========================================\n");
+    printf("NASA IMPORT TEST\n");
+    printf("========================================\n");
+
+    BMS_Import_Result res;
+    BMS_Import_ResultInit(&res);
+
+    /* Charge: auto type, preferred columns, cleaning, extrapolation at both ends */
+    BMS_Import_Status_t st = BMS_Import_CSV(charge_csv, sizeof(charge_csv) - 1u, BMS_CYCLE_AUTO, 1.0f, &res);
+    check(st == IMPORT_OK && res.type == BMS_CYCLE_CHARGE, "charge cycle detected from header");
+    check(res.col_time == 5 && res.col_voltage == 0 && res.col_current == 1 && res.col_temp == 2,
+          "measured columns preferred over charger setpoints");
+    check(res.rows_raw == 5u && res.rows_valid == 3u && res.rows_missing == 2u, "NaN and empty rows dropped");
+    check(res.n == 6u && res.t_start_s == 0.0, "grid floor(t0):dt:ceil(tN)");
+
+    bool lin = true;
+    for (size_t k = 0; k < res.n; k++) {
+        const float t = (float)k;
+        if (!near(res.V[k], 3.45f + 0.1f * t)) lin = false;
+        if (!near(res.I[k], 0.9f + 0.2f * t)) lin = false;   /* |I|, charge positive */
+        if (!near(res.T[k], 23.75f + 0.5f * t)) lin = false;
+    }
+    check(lin, "linear interpolation and extrapolation, charge current positive");
+
+    /* Discharge: alternate names, default temperature, sign, ordering */
+    st = BMS_Import_CSV(discharge_csv, sizeof(discharge_csv) - 1u, BMS_CYCLE_DISCHARGE, 1.0f, &res);
+    check(st == IMPORT_OK && res.rows_order == 1u && res.rows_valid == 3u, "non-increasing time dropped");
+    check(res.n == 4u && res.t_start_s == 10.0 && near(res.V[2], 3.8f) && near(res.V[3], 3.7f),
+          "alternate column names");
+    check(near(res.I[0], -2.0f) && near(res.T[0], 25.0f), "discharge current negative, default temperature");
+
+    /* Half-step grid */
+    st = BMS_Import_CSV(discharge_csv, sizeof(discharge_csv) - 1u, BMS_CYCLE_DISCHARGE, 0.5f, &res);
+    check(st == IMPORT_OK && res.n == 7u && near(res.V[1], 3.95f) && near(res.V[5], 3.75f), "sub-second dt");
+
+    /* Errors and impedance defaults */
+    const char no_time[] = "voltage,current\n3.7,1.0\n3.8,1.0\n";
+    check(BMS_Import_CSV(no_time, sizeof(no_time) - 1u, BMS_CYCLE_AUTO, 1.0f, &res) == IMPORT_ERR_NO_TIME,
+          "missing time column reported");
+    const char one_row[] = "time,voltage,current\n0,3.7,1.0\n";
+    check(BMS_Import_CSV(one_row, sizeof(one_row) - 1u, BMS_CYCLE_AUTO, 1.0f, &res) == IMPORT_ERR_TOO_FEW,
+          "single row rejected");
+    const char imp[] = "Time,Voltage_measured\n0,3.7\n2,3.9\n";
+    st = BMS_Import_CSV(imp, sizeof(imp) - 1u, BMS_CYCLE_AUTO, 1.0f, &res);
+    check(st == IMPORT_OK && res.type == BMS_CYCLE_IMPEDANCE && res.col_current < 0 &&
+          res.I[1] == 0.0f && near(res.V[1], 3.8f), "impedance without current uses zeros");
+
+    /* Cycle file round trip */
+    static uint64_t file_mem[64];
+    st = BMS_Import_CSV(charge_csv, sizeof(charge_csv) - 1u, BMS_CYCLE_AUTO, 1.0f, &res);
+    const size_t bytes = BMS_Cycle_FileSize((uint32_t)res.n);
+    uint8_t *p = (uint8_t *)file_mem;
+    BMS_Cycle_FillHeader((BMS_Cycle_Header *)p, &res);
+    memcpy(p + sizeof(BMS_Cycle_Header), res.V, res.n * sizeof(float));
+    memcpy(p + sizeof(BMS_Cycle_Header) + res.n * sizeof(float), res.I, res.n * sizeof(float));
+    memcpy(p + sizeof(BMS_Cycle_Header) + 2u * res.n * sizeof(float), res.T, res.n * sizeof(float));
+
+    BMS_Cycle_View view;
+    check(bytes <= sizeof(file_mem) && BMS_Cycle_Open(file_mem, bytes, &view), "cycle file opens");
+    check(view.hdr->n_samples == res.n && view.hdr->cycle_type == BMS_CYCLE_CHARGE &&
+          view.V[5] == res.V[5] && view.I[5] == res.I[5] && view.T[5] == res.T[5], "cycle file round trip");
+    check(!BMS_Cycle_Open(file_mem, bytes - 1u, &view), "truncated file rejected");
+    file_mem[0] = 0u;
+    check(!BMS_Cycle_Open(file_mem, bytes, &view), "bad magic rejected");
+
+    BMS_Import_ResultFree(&res);
+
+    if (failures == 0) {
+        printf("\n✅ TEST PASSED - import matches import_nasa.m cleaning and resampling\n");
+        return 0;
+    } else {
+        printf("\n❌ TEST FAILED - %d check(s) failed\n", failures);
+        return 1;
+    }
+}
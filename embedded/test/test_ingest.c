@@ -0,0 +1,177 @@
+
+/*
+ * test_ingest.c - Ingest engine: decode, tick assembly, late/dup handling
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "bms_config.h"
+#include "bms_ingest.h"
+#include "bms_batch.h"
+#include "soc_estimator.h"
+#include "test_vectors.h"
+#include "test_check.h"
+
+#define N_PACKS 2
+#define N_CELLS 3
+
+static uint64_t eng_mem[16384];
+static uint64_t batch_mem[512];
+
+static uint64_t fake_ns = 0u;
+static uint64_t fake_now(void) { return fake_ns; }
+
+static Ingest_Result_t send_at(Ingest_Engine *eng, uint16_t p, uint16_t c, uint32_t tick,
+                               double time_s, float I, float V, uint64_t sent_ns)
+{
+    uint8_t buf[INGEST_FRAME_SIZE];
+    Ingest_EncodeFrame(buf, 0u, p, c, tick, time_s, I, V, 25.0f, sent_ns);
+    return Ingest_Frame(eng, buf, sizeof(buf));
+}
+
+static Ingest_Result_t send_frame(Ingest_Engine *eng, uint16_t p, uint16_t c, uint32_t tick,
+                            float I, float V, uint64_t sent_ns)
+{
+    return send_at(eng, p, c, tick, (double)tick * DT_CORE, I, V, sent_ns);
+}
+
+int main()
+{
+    printf("========================================\n");
+    printf("INGEST ENGINE TEST\n");
+    printf("========================================\n");
+
+    check(Ingest_StateSize(N_PACKS, N_CELLS) <= sizeof(eng_mem), "engine fits test buffer");
+    Ingest_Engine *eng = Ingest_Init(eng_mem, sizeof(eng_mem), N_PACKS, N_CELLS, 1.0f, fake_now);
+    check(eng != NULL, "init");
+    check(Ingest_Init(eng_mem, sizeof(eng_mem), N_PACKS, INGEST_MAX_CELLS_PER_PACK + 1u, 1.0f, NULL) == NULL,
+          "oversized pack rejected");
+    eng = Ingest_Init(eng_mem, sizeof(eng_mem), N_PACKS, N_CELLS, 1.0f, fake_now);
+    if (eng == NULL) {
+        printf("\n❌ TEST FAILED - engine init\n");
+        return 1;
+    }
+
+    /* Reference: same samples through the batch ABI directly */
+    BMS_Batch *ref = BMS_Batch_Init(batch_mem, sizeof(batch_mem), N_CELLS, 1.0f);
+    double t[N_CELLS];
+    float I[N_CELLS], V[N_CELLS], T[N_CELLS], soc[N_CELLS];
+
+    bool match = true;
+    for (uint32_t k = 0; k < NUM_TEST_SAMPLES; k++) {
+        for (uint16_t c = 0; c < N_CELLS; c++) {
+            t[c] = (double)k * DT_CORE;
+            I[c] = test_current[k];
+            V[c] = test_v_meas[k];
+            T[c] = 25.0f;
+
+            /* Every frame reaches the estimator 5 us after it was sent */
+            fake_ns = 1000u * k + 5000u;
+            const Ingest_Result_t r = send_frame(eng, 1u, c, k, I[c], V[c], 1000u * k);
+            if ((c == N_CELLS - 1u) != (r == INGEST_TICK_DONE)) match = false;
+        }
+
+        BMS_Batch_Input in = { t, I, V, T, NULL };
+        BMS_Batch_Output out = { soc, NULL, NULL, NULL, NULL };
+        BMS_Batch_Run(ref, &in, &out, 1u, 1u);
+
+        for (uint32_t c = 0; c < N_CELLS; c++) {
+            if (Ingest_GetSOC(eng, 1u, c) != soc[c]) match = false;
+        }
+    }
+    check(match, "complete ticks run estimators, SOC matches batch ABI");
+
+    const Ingest_Stats *st = Ingest_GetStats(eng);
+    check(st->ticks_done == NUM_TEST_SAMPLES && st->frames_ok == NUM_TEST_SAMPLES * N_CELLS,
+          "tick and frame counters");
+    check(st->lat_count == NUM_TEST_SAMPLES * N_CELLS, "latency recorded per frame");
+    check(Ingest_LatencyPercentile(eng, 100.0f) == 5000u + 1000u, "latency percentile from histogram");
+
+    /* Duplicate, late, bad and out-of-range frames */
+    check(send_frame(eng, 0u, 0u, 10u, -1.0f, 3.9f, 0u) == INGEST_OK, "first frame of pack 0");
+    check(send_frame(eng, 0u, 0u, 10u, -1.0f, 3.9f, 0u) == INGEST_DUPLICATE, "duplicate detected");
+    check(send_frame(eng, 0u, 1u, 9u, -1.0f, 3.9f, 0u) == INGEST_LATE, "late frame dropped");
+    check(send_frame(eng, 0u, 1u, 11u, -1.0f, 3.9f, 0u) == INGEST_TICK_DONE && st->ticks_incomplete == 1u,
+          "newer tick flushes incomplete one");
+    check(Ingest_GetSOC(eng, 0u, 1u) == 1.0f && Ingest_GetSOC(eng, 0u, 2u) == 1.0f &&
+          Ingest_GetFaults(eng, 0u, 1u) == 0u && Ingest_GetFaults(eng, 0u, 2u) == 0u,
+          "cells missing from flushed tick not stepped");
+
+    /* Cell 2 misses tick 12: its tick 13 sample must integrate over 2 * DT_CORE */
+    send_frame(eng, 0u, 0u, 11u, -1.0f, 3.9f, 0u);
+    send_frame(eng, 0u, 2u, 11u, -1.5f, 3.8f, 0u);
+    send_frame(eng, 0u, 0u, 12u, -1.0f, 3.9f, 0u);
+    send_frame(eng, 0u, 1u, 12u, -1.0f, 3.9f, 0u);
+    send_frame(eng, 0u, 0u, 13u, -1.0f, 3.9f, 0u);
+    send_frame(eng, 0u, 1u, 13u, -1.0f, 3.9f, 0u);
+    check(send_frame(eng, 0u, 2u, 13u, -1.5f, 3.8f, 0u) == INGEST_TICK_DONE && st->ticks_incomplete == 2u,
+          "tick with a missing cell flushed by the next one");
+
+    EKF_State gap;
+    EKF_Init(&gap, 1.0f);
+    EKF_Predict(&gap, -1.5f, 0.0f);
+    EKF_Update(&gap, 3.8f, -1.5f);
+    EKF_Predict(&gap, -1.5f, 2.0f * DT_CORE);
+    EKF_Update(&gap, 3.8f, -1.5f);
+    check(Ingest_GetSOC(eng, 0u, 2u) == gap.soc && Ingest_GetFaults(eng, 0u, 2u) == 0u,
+          "missed tick carried into the next sample's dt");
+    check(send_frame(eng, 5u, 0u, 11u, -1.0f, 3.9f, 0u) == INGEST_ERR_RANGE, "pack out of range");
+
+    uint8_t junk[INGEST_FRAME_SIZE] = { 0 };
+    check(Ingest_Frame(eng, junk, sizeof(junk)) == INGEST_ERR_FRAME, "bad magic rejected");
+    check(Ingest_Frame(eng, junk, 7u) == INGEST_ERR_FRAME, "bad length rejected");
+
+    uint8_t end[INGEST_FRAME_SIZE];
+    Ingest_EncodeFrame(end, INGEST_FLAG_END, 0u, 0u, 1234u, 0.0, 0.0f, 0.0f, 0.0f, 0u);
+    check(Ingest_Frame(eng, end, sizeof(end)) == INGEST_END && st->end_frames_sent == 1234u,
+          "END frame carries sent count");
+
+    /* Partial last tick is stepped on flush, not dropped */
+    const float soc_before = Ingest_GetSOC(eng, 0u, 0u);
+    send_frame(eng, 0u, 0u, 14u, -1.0f, 3.9f, 0u);
+    check(Ingest_GetSOC(eng, 0u, 0u) == soc_before, "partial tick held until flushed");
+    check(Ingest_FlushTick(eng) == 1u && Ingest_GetSOC(eng, 0u, 0u) != soc_before &&
+          st->ticks_incomplete == 3u, "flush steps the pending partial tick");
+    check(Ingest_FlushTick(eng) == 0u, "nothing left to flush");
+    check(send_frame(eng, 0u, 1u, 14u, -1.0f, 3.9f, 0u) == INGEST_LATE, "flushed tick is closed");
+
+    /*
+      Epoch timestamps with a 0.25 s step: f32 on the wire would resolve
+      only 128 s here, so every derived dt would be 0 or 128 s. Frames
+      must land on the same states as the batch ABI fed time-since-start.
+    */
+    eng = Ingest_Init(eng_mem, sizeof(eng_mem), 1u, N_CELLS, 1.0f, NULL);
+    ref = BMS_Batch_Init(batch_mem, sizeof(batch_mem), N_CELLS, 1.0f);
+    const double epoch = 1.7e9;
+    const double step = 0.25;
+    bool epoch_match = (eng != NULL && ref != NULL);
+    for (uint32_t k = 0; k < NUM_TEST_SAMPLES && epoch_match; k++) {
+        for (uint16_t c = 0; c < N_CELLS; c++) {
+            t[c] = (double)k * step;
+            I[c] = test_current[k];
+            V[c] = test_v_meas[k];
+            T[c] = 25.0f;
+            send_at(eng, 0u, c, k, epoch + (double)k * step, I[c], V[c], 0u);
+        }
+
+        BMS_Batch_Input in = { t, I, V, T, NULL };
+        BMS_Batch_Output out = { soc, NULL, NULL, NULL, NULL };
+        BMS_Batch_Run(ref, &in, &out, 1u, 1u);
+
+        for (uint32_t c = 0; c < N_CELLS; c++) {
+            if (Ingest_GetSOC(eng, 0u, c) != soc[c]) epoch_match = false;
+        }
+    }
+    check(epoch_match, "epoch timestamps keep 0.25 s dt exact through the wire");
+
+    if (failures == 0) {
+        printf("\n✅ TEST PASSED - ingest engine assembles ticks correctly\n");
+        return 0;
+    } else {
+        printf("\n❌ TEST FAILED - %d check(s) failed\n", failures);
+        return 1;
+    }
+}
@@ -0,0 +1,195 @@
+
+/*
+ * test_scheduler.c - Multi-rate scheduler: rates, priority, WCET, shedding
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "bms_config.h"
+#include "bms_scheduler.h"
+#include "bms_tasks.h"
+#include "test_check.h"
+
+/* Fake clock: each task advances it by its configured cost */
+static uint32_t fake_us = 0u;
+static uint32_t fake_now(void) { return fake_us; }
+
+typedef struct {
+    uint32_t cost_us;
+    uint32_t ticks_total;   /* sum of ticks_elapsed seen */
+    char     tag;
+} Fake_Task;
+
+static char trace[64];
+static int  trace_len = 0;
+
+static void fake_task(void *ctx, uint32_t ticks_elapsed)
+{
+    Fake_Task *t = (Fake_Task *)ctx;
+    fake_us += t->cost_us;
+    t->ticks_total += ticks_elapsed;
+    if (trace_len < (int)sizeof(trace) - 1) trace[trace_len++] = t->tag;
+}
+
+int main()
+{
+    printf("========================================\n");
+    printf("SCHEDULER TEST\n");
+    printf("========================================\n");
+
+    Scheduler sched;
+    Sched_Init(&sched, fake_now, 100u);
+
+    Fake_Task fast = { 10u, 0u, 'S' };
+    Fake_Task mid  = { 30u, 0u, 'E' };
+    Fake_Task slow = { 80u, 0u, 'H' };
+
+    /* Added out of priority order on purpose */
+    const int id_slow = Sched_AddTask(&sched, "slow", fake_task, &slow, 0u, 0u, 2u, 70u, false);
+    const int id_mid  = Sched_AddTask(&sched, "mid",  fake_task, &mid,  4u, 0u, 1u, 40u, false);
+    const int id_fast = Sched_AddTask(&sched, "fast", fake_task, &fast, 1u, 0u, 0u, 20u, true);
+
+    check(Sched_AddTask(&sched, "bad", fake_task, NULL, 2u, 2u, 0u, 0u, false) < 0,
+          "offset >= period rejected");
+
+    /* Tick 0: fast and mid due, dispatched by priority */
+    Sched_RunTick(&sched);
+    trace[trace_len] = '\0';
+    check(trace[0] == 'S' && trace[1] == 'E' && trace_len == 2, "priority order on tick 0");
+
+    for (int i = 1; i < 20; i++) Sched_RunTick(&sched);
+
+    const Sched_Task *t_fast = Sched_GetTask(&sched, id_fast);
+    const Sched_Task *t_mid  = Sched_GetTask(&sched, id_mid);
+    const Sched_Task *t_slow = Sched_GetTask(&sched, id_slow);
+
+    check(t_fast->run_count == 20u, "fast task runs every tick");
+    check(t_mid->run_count == 5u,   "mid task runs every 4th tick");
+    check(mid.ticks_total == 17u,   "mid task sees elapsed ticks (1 + 4*4)");
+    check(t_slow->run_count == 0u,  "trigger-only task idle until triggered");
+    check(t_fast->wcet_us == 10u && t_fast->overrun_count == 0u, "fast WCET within budget");
+
+    /* Slow task declares 70 us: does not fit after fast + mid on tick 20 */
+    Sched_Trigger(&sched, id_slow);
+    Sched_RunTick(&sched);   /* tick 20: 40 us used + 70 us declared > 100 */
+    check(t_slow->shed_count == 1u && t_slow->run_count == 0u, "slow task shed when tick is full");
+    check(t_slow->pending, "shed task stays pending");
+
+    /* Lower-priority work must not overtake the shed task */
+    Fake_Task tiny = { 1u, 0u, 'T' };
+    const int id_tiny = Sched_AddTask(&sched, "tiny", fake_task, &tiny, 0u, 0u, 3u, 1u, false);
+    const Sched_Task *t_tiny = Sched_GetTask(&sched, id_tiny);
+    Sched_Trigger(&sched, id_tiny);
+    Sched_Trigger(&sched, id_mid);
+    Sched_RunTick(&sched);   /* tick 21: fast + mid = 40 us, slow shed again, tiny would fit */
+    check(t_slow->shed_count == 2u && t_tiny->run_count == 0u && t_tiny->shed_count == 1u,
+          "no lower-priority dispatch after a shed");
+
+    Sched_RunTick(&sched);   /* tick 22: fast only, then slow fits */
+    check(t_slow->run_count == 1u, "shed task runs on next tick with slack");
+    check(t_slow->wcet_us == 80u && t_slow->overrun_count == 1u, "slow overrun recorded");
+    check(sched.tick_overruns == 0u, "no tick exceeded budget");
+    check(t_tiny->run_count == 1u, "lower-priority task runs once the shed one has");
+    check(sched.tick_wcet_us == 91u, "tick WCET recorded");
+
+    /* Critical task is never shed, even when the tick is blown */
+    fast.cost_us = 150u;
+    Sched_RunTick(&sched);
+    check(t_fast->run_count == 24u && t_fast->overrun_count == 1u, "critical task never shed");
+    check(sched.tick_overruns == 1u, "tick overrun counted");
+
+    Sched_ResetStats(&sched);
+    check(t_fast->run_count == 0u && t_fast->wcet_us == 0u && sched.tick_wcet_us == 0u,
+          "statistics reset");
+
+    /* Standard BMS binding */
+    {
+        BMS_State bms[2];
+        EKF_State ekf[2];
+        SOH_State soh[2];
+        Safety_FSM fsm[2];
+        BMS_Cell_Acc acc[2];
+        float current[2] = { -1.0f, -1.0f };
+        float voltage[2] = { 3.9f, 3.9f };
+        float temp[2]    = { 25.0f, 25.0f };
+
+        for (int c = 0; c < 2; c++) {
+            BMS_Init(&bms[c]);
+            EKF_Init(&ekf[c], 1.0f);
+            SOH_Init(&soh[c], NOMINAL_CAPACITY);
+            Safety_Init(&fsm[c]);
+        }
+
+        BMS_Pack pack = { 2u, bms, ekf, soh, fsm, acc, current, voltage, temp, SCHED_TICK_DT, NULL, -1 };
+        BMS_Task_Config cfg;
+        BMS_Tasks_DefaultConfig(&cfg);
+
+        Scheduler bms_sched;
+        int ids[BMS_TASK_COUNT];
+        Sched_Init(&bms_sched, NULL, 0u);
+        check(BMS_Tasks_Register(&bms_sched, &pack, &cfg, ids), "BMS tasks registered");
+
+        for (int i = 0; i < 100; i++) Sched_RunTick(&bms_sched);
+
+        check(Sched_GetTask(&bms_sched, ids[BMS_TASK_SAFETY])->run_count == 100u, "safety every tick");
+        check(Sched_GetTask(&bms_sched, ids[BMS_TASK_EKF])->run_count == 100u / SCHED_RATE_EKF, "EKF at configured rate");
+        check(bms[0].step_count == 100u / SCHED_RATE_ECM, "ECM at configured rate");
+        check(Safety_GetState(&fsm[0]) == BMS_STATE_DISCHARGING, "safety FSM driven");
+        check(Sched_GetTask(&bms_sched, ids[BMS_TASK_SOH])->run_count == 0u, "SOH idle during discharge");
+
+        /* ECM and EKF every 5th tick; current flows only on the ticks between */
+        EKF_State ekf_ref;
+        BMS_Init(&bms[0]);
+        EKF_Init(&ekf[0], 1.0f);
+        EKF_Init(&ekf_ref, 1.0f);
+        cfg.period_ticks[BMS_TASK_ECM] = 5u;
+        cfg.period_ticks[BMS_TASK_EKF] = 5u;
+        Sched_Init(&bms_sched, NULL, 0u);
+        BMS_Tasks_Register(&bms_sched, &pack, &cfg, ids);
+        for (uint32_t k = 0; k < 96u; k++) {
+            current[0] = current[1] = (k % 5u == 0u) ? 0.0f : -1.0f;
+            Sched_RunTick(&bms_sched);
+            if (k % 5u == 0u) {
+                EKF_Predict(&ekf_ref, (k == 0u) ? 0.0f : -0.8f, (k == 0u) ? 1.0f : 5.0f);
+                EKF_Update(&ekf_ref, voltage[0], 0.0f);
+            }
+        }
+        const float soc_expect = 1.0f - 76.0f / (NOMINAL_CAPACITY * 3600.0f);
+        check(fabsf(bms[0].soc - soc_expect) < 1e-5f, "ECM keeps the charge of skipped ticks");
+        check(fabsf(ekf[0].soc - ekf_ref.soc) < 1e-6f, "EKF predicts with mean current of skipped ticks");
+
+        /* SOH runs once, at the end of a 400 s discharge */
+        BMS_Tasks_DefaultConfig(&cfg);
+        SOH_Init(&soh[0], NOMINAL_CAPACITY);
+        Sched_Init(&bms_sched, NULL, 0u);
+        BMS_Tasks_Register(&bms_sched, &pack, &cfg, ids);
+        const Sched_Task *t_soh = Sched_GetTask(&bms_sched, ids[BMS_TASK_SOH]);
+        for (uint32_t k = 0; k < 400u; k++) {
+            current[0] = current[1] = -1.0f;
+            voltage[0] = voltage[1] = 3.5f - 0.75f * (float)k / 400.0f;
+            Sched_RunTick(&bms_sched);
+        }
+        check(t_soh->run_count == 0u && fabsf(acc[0].soh_As - 400.0f) < 1e-3f,
+              "discharge accumulated, SOH not yet run");
+        current[0] = current[1] = 0.0f;
+        voltage[0] = voltage[1] = 2.78f;
+        Sched_RunTick(&bms_sched);
+        check(t_soh->run_count == 1u && soh[0].total_cycles == 1u && soh[0].discharged_Ah == 0.0f,
+              "SOH triggered at cycle end and books the cycle");
+
+        cfg.period_ticks[BMS_TASK_SAFETY] = 2u;
+        Sched_Init(&bms_sched, NULL, 0u);
+        check(!BMS_Tasks_Register(&bms_sched, &pack, &cfg, NULL), "slow safety rejected");
+    }
+
+    if (failures == 0) {
+        printf("\n✅ TEST PASSED - scheduler behaves as specified\n");
+        return 0;
+    } else {
+        printf("\n❌ TEST FAILED - %d check(s) failed\n", failures);
+        return 1;
+    }
+}
@@ -0,0 +1,159 @@
+
+/*
+ * bms_framegen.c - Stand-in telemetry source for bms_ingestd (Linux)
+ *
+ * Sends one frame per cell per tick for every pack, replaying the test
+ * vectors, batched with sendmmsg. Ends with an END frame carrying the
+ * number of frames sent so the daemon can report loss.
+ *
+ *   bms_framegen (--udp PORT | --unix PATH) [--packs N] [--cells M]
+ *                [--ticks T] [--rate HZ]
+ *
+ * --rate is pack ticks per second (0 = as fast as possible).
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+
+#include "bms_config.h"
+#include "bms_ingest.h"
+#include "test_vectors.h"
+
+#define FRAMEGEN_BATCH (64u)
+
+static uint64_t mono_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s (--udp PORT | --unix PATH) [--packs N] [--cells M] [--ticks T] [--rate HZ]\n", prog);
+}
+
+static uint8_t bufs[FRAMEGEN_BATCH][INGEST_FRAME_SIZE];
+static struct iovec iov[FRAMEGEN_BATCH];
+static struct mmsghdr msgs[FRAMEGEN_BATCH];
+
+/* Send queued frames; blocking socket so Unix datagrams apply backpressure */
+static uint64_t flush(int fd, uint32_t count)
+{
+    uint32_t done = 0u;
+    while (done < count) {
+        const int n = sendmmsg(fd, msgs + done, count - done, 0);
+        if (n <= 0) break;
+        done += (uint32_t)n;
+    }
+    return done;
+}
+
+int main(int argc, char **argv)
+{
+    int udp_port = 0;
+    const char *unix_path = NULL;
+    uint32_t n_packs = 16u;
+    uint32_t n_cells = 96u;
+    uint32_t n_ticks = 1000u;
+    double rate_hz = 0.0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--udp") && i + 1 < argc)        udp_port = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--unix") && i + 1 < argc)  unix_path = argv[++i];
+        else if (!strcmp(argv[i], "--packs") && i + 1 < argc) n_packs = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--cells") && i + 1 < argc) n_cells = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--ticks") && i + 1 < argc) n_ticks = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--rate") && i + 1 < argc)  rate_hz = atof(argv[++i]);
+        else { usage(argv[0]); return 2; }
+    }
+    if (udp_port <= 0 && unix_path == NULL) { usage(argv[0]); return 2; }
+
+    int fd;
+    if (unix_path != NULL) {
+        struct sockaddr_un addr;
+        if (strlen(unix_path) >= sizeof(addr.sun_path)) return 2;
+        fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strcpy(addr.sun_path, unix_path);
+        if (fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+            perror("framegen: connect");
+            return 1;
+        }
+    } else {
+        struct sockaddr_in addr;
+        fd = socket(AF_INET, SOCK_DGRAM, 0);
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons((uint16_t)udp_port);
+        if (fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+            perror("framegen: connect");
+            return 1;
+        }
+    }
+
+    for (uint32_t i = 0; i < FRAMEGEN_BATCH; i++) {
+        iov[i].iov_base = bufs[i];
+        iov[i].iov_len = INGEST_FRAME_SIZE;
+        memset(&msgs[i], 0, sizeof(msgs[i]));
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    const uint64_t t_start = mono_ns();
+    const uint64_t period_ns = (rate_hz > 0.0) ? (uint64_t)(1e9 / rate_hz) : 0u;
+    uint64_t sent = 0u;
+    uint32_t queued = 0u;
+
+    for (uint32_t tick = 0; tick < n_ticks; tick++) {
+        if (period_ns > 0u) {
+            const uint64_t due = t_start + (uint64_t)tick * period_ns;
+            struct timespec ts = { (time_t)(due / 1000000000u), (long)(due % 1000000000u) };
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+        }
+
+        const uint32_t s = tick % NUM_TEST_SAMPLES;
+        const double t = (double)tick * DT_CORE;
+
+        for (uint32_t p = 0; p < n_packs; p++) {
+            for (uint32_t c = 0; c < n_cells; c++) {
+                const float scale = 1.0f - 0.1f * (float)(c % 8u) / 8.0f;
+                Ingest_EncodeFrame(bufs[queued], 0u, (uint16_t)p, (uint16_t)c, tick,
+                                   t, test_current[s] * scale, test_v_meas[s], 25.0f,
+                                   mono_ns());
+                if (++queued == FRAMEGEN_BATCH) {
+                    sent += flush(fd, queued);
+                    queued = 0u;
+                }
+            }
+        }
+    }
+    sent += flush(fd, queued);
+
+    const double secs = (double)(mono_ns() - t_start) * 1e-9;
+
+    /* END marker, repeated in case a datagram is dropped */
+    for (int i = 0; i < 3; i++) {
+        Ingest_EncodeFrame(bufs[0], INGEST_FLAG_END, 0u, 0u, (uint32_t)sent,
+                           0.0, 0.0f, 0.0f, 0.0f, mono_ns());
+        flush(fd, 1u);
+    }
+
+    fprintf(stderr, "framegen: sent %llu frames in %.2f s (%.0f frames/s)\n",
+            (unsigned long long)sent, secs, (secs > 0.0) ? (double)sent / secs : 0.0);
+
+    close(fd);
+    return 0;
+}
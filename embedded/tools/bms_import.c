@@ -0,0 +1,244 @@
+
+/*
+ * bms_import.c - Parallel NASA CSV import / clean / resample tool (Linux)
+ *
+ * C counterpart of matlab/01_import_clean/batch_import_nasa.m. Each CSV is
+ * mmap'd, cleaned and resampled to DT_CORE in one pass (BMS_Import_CSV)
+ * and written as a binary cycle file <outdir>/<name>.cyc. Files are
+ * spread over a pthread worker pool; throughput is reported in MB/s.
+ *
+ *   bms_import [-j THREADS] [--type auto|charge|discharge|impedance]
+ *              [-o OUTDIR] FILE.csv...
+ *
+ * With --type auto, cycles detected as impedance are skipped, as in
+ * batch_import_nasa.m.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "bms_config.h"
+#include "bms_import.h"
+
+#define IMPORT_MAX_THREADS (64)
+
+typedef struct {
+    char **files;
+    int n_files;
+    const char *out_dir;
+    BMS_Cycle_Type type;
+    atomic_int next;
+} Job;
+
+typedef struct {
+    Job *job;
+    uint64_t bytes_in;
+    uint64_t bytes_out;
+    uint64_t rows;
+    uint64_t samples;
+    int ok;
+    int failed;
+    int skipped;
+} Worker;
+
+static uint64_t mono_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-j THREADS] [--type auto|charge|discharge|impedance] [-o OUTDIR] FILE.csv...\n", prog);
+}
+
+/* <out_dir>/<basename without extension>.cyc */
+static void out_path(char *dst, size_t cap, const char *out_dir, const char *src)
+{
+    const char *base = strrchr(src, '/');
+    base = (base != NULL) ? base + 1 : src;
+    const char *dot = strrchr(base, '.');
+    const int len = (dot != NULL) ? (int)(dot - base) : (int)strlen(base);
+    snprintf(dst, cap, "%s/%.*s.cyc", out_dir, len, base);
+}
+
+static bool write_all(int fd, const void *buf, size_t len)
+{
+    const uint8_t *p = buf;
+    while (len > 0u) {
+        const ssize_t n = write(fd, p, len);
+        if (n <= 0) return false;
+        p += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+static bool write_cycle(const char *path, const BMS_Import_Result *res)
+{
+    BMS_Cycle_Header hdr;
+    BMS_Cycle_FillHeader(&hdr, res);
+
+    const int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+
+    const size_t col = res->n * sizeof(float);
+    const bool ok = write_all(fd, &hdr, sizeof(hdr))
+                 && write_all(fd, res->V, col)
+                 && write_all(fd, res->I, col)
+                 && write_all(fd, res->T, col);
+    close(fd);
+    return ok;
+}
+
+static void import_one(Worker *w, BMS_Import_Result *res, const char *path)
+{
+    const int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size == 0) {
+        fprintf(stderr, "import: %s: cannot read\n", path);
+        if (fd >= 0) close(fd);
+        w->failed++;
+        return;
+    }
+
+    const size_t len = (size_t)st.st_size;
+    const char *text = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (text == MAP_FAILED) {
+        fprintf(stderr, "import: %s: mmap failed\n", path);
+        w->failed++;
+        return;
+    }
+    madvise((void *)text, len, MADV_SEQUENTIAL);
+
+    const BMS_Import_Status_t status = BMS_Import_CSV(text, len, w->job->type, DT_CORE, res);
+    munmap((void *)text, len);
+    w->bytes_in += len;
+
+    if (status != IMPORT_OK) {
+        fprintf(stderr, "import: %s: %s\n", path, BMS_Import_StatusString(status));
+        w->failed++;
+        return;
+    }
+    if (w->job->type == BMS_CYCLE_AUTO && res->type == BMS_CYCLE_IMPEDANCE) {
+        w->skipped++;
+        return;
+    }
+
+    char dst[4096];
+    out_path(dst, sizeof(dst), w->job->out_dir, path);
+    if (!write_cycle(dst, res)) {
+        fprintf(stderr, "import: %s: write failed\n", dst);
+        w->failed++;
+        return;
+    }
+
+    w->bytes_out += BMS_Cycle_FileSize((uint32_t)res->n);
+    w->rows += res->rows_raw;
+    w->samples += res->n;
+    w->ok++;
+}
+
+static void *worker_main(void *arg)
+{
+    Worker *w = arg;
+    BMS_Import_Result res;
+    BMS_Import_ResultInit(&res);
+
+    for (;;) {
+        const int i = atomic_fetch_add(&w->job->next, 1);
+        if (i >= w->job->n_files) break;
+        import_one(w, &res, w->job->files[i]);
+    }
+
+    BMS_Import_ResultFree(&res);
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    int n_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    Job job = { NULL, 0, ".", BMS_CYCLE_AUTO, 0 };
+    int first_file = argc;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-j") && i + 1 < argc)          n_threads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc)     job.out_dir = argv[++i];
+        else if (!strcmp(argv[i], "--type") && i + 1 < argc) {
+            const char *t = argv[++i];
+            if (!strcmp(t, "auto"))           job.type = BMS_CYCLE_AUTO;
+            else if (!strcmp(t, "charge"))    job.type = BMS_CYCLE_CHARGE;
+            else if (!strcmp(t, "discharge")) job.type = BMS_CYCLE_DISCHARGE;
+            else if (!strcmp(t, "impedance")) job.type = BMS_CYCLE_IMPEDANCE;
+            else { usage(argv[0]); return 2; }
+        }
+        else if (argv[i][0] == '-') { usage(argv[0]); return 2; }
+        else { first_file = i; break; }
+    }
+    if (first_file >= argc) { usage(argv[0]); return 2; }
+
+    job.files = argv + first_file;
+    job.n_files = argc - first_file;
+    if (n_threads < 1) n_threads = 1;
+    if (n_threads > IMPORT_MAX_THREADS) n_threads = IMPORT_MAX_THREADS;
+    if (n_threads > job.n_files) n_threads = job.n_files;
+
+    static Worker workers[IMPORT_MAX_THREADS];
+    pthread_t threads[IMPORT_MAX_THREADS];
+    bool started[IMPORT_MAX_THREADS];
+
+    const uint64_t t_start = mono_ns();
+    for (int t = 0; t < n_threads; t++) {
+        memset(&workers[t], 0, sizeof(workers[t]));
+        workers[t].job = &job;
+        started[t] = (pthread_create(&threads[t], NULL, worker_main, &workers[t]) == 0);
+        if (!started[t]) {
+            /* Drain the queue on this thread instead; started workers share it */
+            fprintf(stderr, "import: thread %d failed to start, parsing inline\n", t);
+            worker_main(&workers[t]);
+        }
+    }
+
+    Worker total;
+    memset(&total, 0, sizeof(total));
+    for (int t = 0; t < n_threads; t++) {
+        if (started[t]) pthread_join(threads[t], NULL);
+        total.bytes_in  += workers[t].bytes_in;
+        total.bytes_out += workers[t].bytes_out;
+        total.rows      += workers[t].rows;
+        total.samples   += workers[t].samples;
+        total.ok        += workers[t].ok;
+        total.failed    += workers[t].failed;
+        total.skipped   += workers[t].skipped;
+    }
+    const double secs = (double)(mono_ns() - t_start) * 1e-9;
+
+    printf("========================================\n");
+    printf("IMPORT REPORT\n");
+    printf("========================================\n");
+    printf("Threads:          %d\n", n_threads);
+    printf("Files:            %d ok, %d failed, %d skipped (impedance)\n",
+           total.ok, total.failed, total.skipped);
+    printf("Rows in:          %llu\n", (unsigned long long)total.rows);
+    printf("Samples out:      %llu (dt = %.2f s)\n", (unsigned long long)total.samples, DT_CORE);
+    printf("CSV in:           %.1f MB\n", (double)total.bytes_in / 1e6);
+    printf("Cycle files out:  %.1f MB\n", (double)total.bytes_out / 1e6);
+    printf("Wall time:        %.3f s\n", secs);
+    printf("Throughput:       %.1f MB/s\n", (secs > 0.0) ? (double)total.bytes_in / 1e6 / secs : 0.0);
+
+    return (total.failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,251 @@
+
+/*
+ * bms_ingestd.c - Local telemetry ingest daemon (Linux)
+ *
+ * Receives per-cell frames over UDP or a Unix datagram socket, batches
+ * reads with recvmmsg, decodes straight into preallocated pack batches
+ * and runs the estimators when a pack tick is complete. Prints sustained
+ * frames/s and end-to-end latency percentiles on exit.
+ *
+ *   bms_ingestd (--udp PORT | --unix PATH) [--packs N] [--cells M]
+ *               [--idle-exit S]
+ *
+ * Exits on an END frame from the sender, SIGINT/SIGTERM, or after
+ * S seconds without traffic once traffic has started.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+
+#include "bms_ingest.h"
+
+#define INGESTD_BATCH    (64u)     /* datagrams per recvmmsg */
+#define INGESTD_RCVBUF   (8 * 1024 * 1024)
+
+static uint64_t mono_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s (--udp PORT | --unix PATH) [--packs N] [--cells M] [--idle-exit S]\n", prog);
+}
+
+static int open_socket(int udp_port, const char *unix_path)
+{
+    int fd;
+
+    if (unix_path != NULL) {
+        struct sockaddr_un addr;
+        if (strlen(unix_path) >= sizeof(addr.sun_path)) return -1;
+
+        fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+        if (fd < 0) return -1;
+
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strcpy(addr.sun_path, unix_path);
+        unlink(unix_path);
+        if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+            close(fd);
+            return -1;
+        }
+    } else {
+        struct sockaddr_in addr;
+
+        fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+        if (fd < 0) return -1;
+
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons((uint16_t)udp_port);
+        if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+            close(fd);
+            return -1;
+        }
+    }
+
+    const int rcvbuf = INGESTD_RCVBUF;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    return fd;
+}
+
+int main(int argc, char **argv)
+{
+    int udp_port = 0;
+    const char *unix_path = NULL;
+    uint32_t n_packs = 16u;
+    uint32_t n_cells = 96u;
+    int idle_exit_s = 2;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--udp") && i + 1 < argc)            udp_port = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--unix") && i + 1 < argc)      unix_path = argv[++i];
+        else if (!strcmp(argv[i], "--packs") && i + 1 < argc)     n_packs = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--cells") && i + 1 < argc)     n_cells = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--idle-exit") && i + 1 < argc) idle_exit_s = atoi(argv[++i]);
+        else { usage(argv[0]); return 2; }
+    }
+    if (udp_port <= 0 && unix_path == NULL) { usage(argv[0]); return 2; }
+
+    /* All memory is allocated once, up front */
+    const size_t eng_bytes = Ingest_StateSize(n_packs, n_cells);
+    void *eng_mem = aligned_alloc(64, (eng_bytes + 63u) & ~(size_t)63u);
+    Ingest_Engine *eng = (eng_mem != NULL)
+                       ? Ingest_Init(eng_mem, eng_bytes, n_packs, n_cells, 1.0f, mono_ns)
+                       : NULL;
+    if (eng == NULL) {
+        fprintf(stderr, "ingestd: cannot set up %u packs x %u cells\n", n_packs, n_cells);
+        return 1;
+    }
+
+    static uint8_t bufs[INGESTD_BATCH][64];
+    static struct iovec iov[INGESTD_BATCH];
+    static struct mmsghdr msgs[INGESTD_BATCH];
+    for (uint32_t i = 0; i < INGESTD_BATCH; i++) {
+        iov[i].iov_base = bufs[i];
+        iov[i].iov_len = sizeof(bufs[i]);
+        memset(&msgs[i], 0, sizeof(msgs[i]));
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    const int sock = open_socket(udp_port, unix_path);
+    if (sock < 0) {
+        perror("ingestd: socket");
+        return 1;
+    }
+
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    sigprocmask(SIG_BLOCK, &mask, NULL);
+    const int sig_fd = signalfd(-1, &mask, SFD_NONBLOCK);
+
+    const int tmr_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+    struct itimerspec its = { { 1, 0 }, { 1, 0 } };
+    timerfd_settime(tmr_fd, 0, &its, NULL);
+
+    const int ep = epoll_create1(0);
+    struct epoll_event ev;
+    ev.events = EPOLLIN; ev.data.fd = sock;    epoll_ctl(ep, EPOLL_CTL_ADD, sock, &ev);
+    ev.events = EPOLLIN; ev.data.fd = sig_fd;  epoll_ctl(ep, EPOLL_CTL_ADD, sig_fd, &ev);
+    ev.events = EPOLLIN; ev.data.fd = tmr_fd;  epoll_ctl(ep, EPOLL_CTL_ADD, tmr_fd, &ev);
+
+    if (unix_path != NULL) fprintf(stderr, "ingestd: %u packs x %u cells on unix:%s\n", n_packs, n_cells, unix_path);
+    else                   fprintf(stderr, "ingestd: %u packs x %u cells on udp:127.0.0.1:%d\n", n_packs, n_cells, udp_port);
+
+    uint64_t t_first = 0u, t_last = 0u;
+    uint64_t recv_calls = 0u, datagrams = 0u;
+    uint64_t frames_at_last_timer = 0u;
+    int idle_s = 0;
+    bool running = true;
+
+    while (running) {
+        struct epoll_event events[4];
+        const int n = epoll_wait(ep, events, 4, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("ingestd: epoll_wait");
+            break;
+        }
+
+        for (int e = 0; e < n; e++) {
+            const int fd = events[e].data.fd;
+
+            if (fd == sock) {
+                /* Drain the socket in recvmmsg batches */
+                for (;;) {
+                    const int got = recvmmsg(sock, msgs, INGESTD_BATCH, MSG_DONTWAIT, NULL);
+                    if (got <= 0) break;
+                    recv_calls++;
+                    datagrams += (uint64_t)got;
+
+                    const uint64_t now = mono_ns();
+                    if (t_first == 0u) t_first = now;
+                    t_last = now;
+
+                    for (int m = 0; m < got; m++) {
+                        if (Ingest_Frame(eng, bufs[m], msgs[m].msg_len) == INGEST_END) {
+                            running = false;
+                        }
+                    }
+                }
+            } else if (fd == sig_fd) {
+                struct signalfd_siginfo si;
+                while (read(sig_fd, &si, sizeof(si)) == (ssize_t)sizeof(si)) { }
+                running = false;
+            } else if (fd == tmr_fd) {
+                uint64_t expirations;
+                while (read(tmr_fd, &expirations, sizeof(expirations)) == (ssize_t)sizeof(expirations)) { }
+
+                const uint64_t ok = Ingest_GetStats(eng)->frames_ok;
+                if (t_first != 0u && ok == frames_at_last_timer) {
+                    if (++idle_s >= idle_exit_s) running = false;
+                } else {
+                    idle_s = 0;
+                }
+                frames_at_last_timer = ok;
+            }
+        }
+    }
+
+    /* Last tick may be partial (END, signal or idle exit): step what arrived */
+    Ingest_FlushTick(eng);
+
+    const Ingest_Stats *st = Ingest_GetStats(eng);
+    const double secs = (t_last > t_first) ? (double)(t_last - t_first) * 1e-9 : 0.0;
+
+    printf("========================================\n");
+    printf("INGEST REPORT (%u packs x %u cells)\n", n_packs, n_cells);
+    printf("========================================\n");
+    printf("Frames ok:        %llu\n", (unsigned long long)st->frames_ok);
+    if (st->end_frames_sent > 0u) {
+        const uint64_t sent = st->end_frames_sent;
+        printf("Frames sent:      %llu (loss %.3f%%)\n", (unsigned long long)sent,
+               100.0 * (double)(sent - ((st->frames_ok < sent) ? st->frames_ok : sent)) / (double)sent);
+    }
+    printf("Bad/late/dup:     %llu / %llu / %llu\n",
+           (unsigned long long)st->frames_bad, (unsigned long long)st->frames_late,
+           (unsigned long long)st->frames_dup);
+    printf("Ticks done:       %llu (incomplete %llu)\n",
+           (unsigned long long)st->ticks_done, (unsigned long long)st->ticks_incomplete);
+    printf("recvmmsg calls:   %llu (%.1f frames/call)\n", (unsigned long long)recv_calls,
+           (recv_calls > 0u) ? (double)datagrams / (double)recv_calls : 0.0);
+    printf("Sustained rate:   %.0f frames/s over %.2f s\n",
+           (secs > 0.0) ? (double)st->frames_ok / secs : 0.0, secs);
+    printf("Latency p50/p90/p99/p99.9: %.1f / %.1f / %.1f / %.1f us, max %.1f us\n",
+           (double)Ingest_LatencyPercentile(eng, 50.0f) * 1e-3,
+           (double)Ingest_LatencyPercentile(eng, 90.0f) * 1e-3,
+           (double)Ingest_LatencyPercentile(eng, 99.0f) * 1e-3,
+           (double)Ingest_LatencyPercentile(eng, 99.9f) * 1e-3,
+           (double)st->lat_max_ns * 1e-3);
+
+    close(ep);
+    close(tmr_fd);
+    close(sig_fd);
+    close(sock);
+    if (unix_path != NULL) unlink(unix_path);
+    free(eng_mem);
+    return 0;
+}